@@ -8,9 +8,16 @@
 #define INCLUDE_ECV_HPP
 
 // Standard headers
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
 #include <limits>
 #include <memory>
+#include <memory_resource>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 /*!
@@ -23,6 +30,128 @@ namespace ecv {
  */
 typedef std::vector<std::string> State;
 
+/*!
+ * \brief SparseMatrix is a read-only CSR (compressed sparse row) view of an adjacency matrix.
+ *
+ * Row \a i owns the column indices `_indices[_offsets[i]] .. _indices[_offsets[i + 1] - 1]`,
+ * which must be strictly increasing. The view does not own its arrays : they can live in a
+ * std::vector as well as in a memory-mapped file.
+ */
+struct SparseMatrix
+{
+    size_t          _rows{ 0 };          ///< Number of rows
+    size_t          _cols{ 0 };          ///< Number of columns
+    int             _primary{ -1 };      ///< Number of primary columns (-1 means every column)
+    const uint64_t* _offsets{ nullptr }; ///< \a _rows + 1 row offsets into \a _indices
+    const uint32_t* _indices{ nullptr }; ///< Column index of every non-zero entry
+};
+
+/*!
+ * \brief Engine lists the search algorithms a problem can be solved with
+ */
+enum class Engine
+{
+    Links,    ///< Dancing links (default, available for every problem)
+    Bitboard, ///< Bitmask backtracking, specialized for the N-Queens problem
+    Cells,    ///< Dancing cells : sparse sets instead of linked lists, for better cache behavior
+    Learning  ///< Dancing links learning from their failures, for unsatisfiable and hard problems
+};
+
+/*!
+ * \brief Layout lists the ways the dancing links nodes can be laid out in memory.
+ * It never changes the search itself (nor the solutions, or their order).
+ */
+enum class Layout
+{
+    Input,   ///< Columns and rows in the order of the adjacency matrix (default)
+    Locality ///< Rows sharing columns next to each other, following a bandwidth-reducing order
+};
+
+/*!
+ * \brief Zdd is a zero-suppressed decision diagram representing a set of solutions.
+ *
+ * Every node stands for a row : its \a _hi branch leads to the solutions holding the row, its
+ * \a _lo branch to the ones that do not. Each path from \a _root to \a TOP is a solution, made of
+ * the rows of the nodes it leaves through their \a _hi branch.
+ */
+struct Zdd
+{
+    static constexpr uint32_t BOTTOM{ 0 }; ///< Terminal node : no solution
+    static constexpr uint32_t TOP{ 1 };    ///< Terminal node : the empty solution
+
+    struct Node
+    {
+        int      _row; ///< Row identifier
+        uint32_t _lo;  ///< Node of the solutions without the row
+        uint32_t _hi;  ///< Node of the solutions with the row
+    };
+
+    std::vector<Node> _nodes{}; ///< Terminals first, then every node after its children
+    uint32_t          _root{ BOTTOM };
+
+    /*!
+     * \brief count Count the solutions represented by the diagram
+     * \return The number of solutions (saturated to UINT64_MAX)
+     */
+    uint64_t count(void) const noexcept;
+};
+
+/*!
+ * \brief Estimate is the predicted size of a complete search, along with the bounds of its 95%
+ * confidence interval.
+ *
+ * The intervals assume the probes mean is normally distributed : with few probes on irregular
+ * search trees, the actual values may well lie outside of them.
+ */
+struct Estimate
+{
+    struct Value
+    {
+        double _mean{ 0 }; ///< Estimated value
+        double _low{ 0 };  ///< Lower bound of the confidence interval
+        double _high{ 0 }; ///< Upper bound of the confidence interval
+    };
+
+    Value    _nodes{};     ///< Nodes of the search tree (the root being the first one)
+    Value    _solutions{}; ///< Solutions to the problem
+    Value    _seconds{};   ///< Time a complete search would take, on the dancing links engine
+    uint32_t _probes{ 0 }; ///< Number of random paths it is based on
+};
+
+/*!
+ * \brief Learning is the work done by the last search of the \a Engine::Learning engine.
+ *
+ * Every failure is explained by the earlier rows choices that emptied a column : the set of those
+ * rows, which no solution can hold together, is a nogood. The search backjumps over the levels
+ * the failure does not depend on, and skips the rows completing a known nogood.
+ */
+struct Learning
+{
+    uint64_t _nodes{ 0 };     ///< Nodes of the search tree explored
+    uint64_t _nogoods{ 0 };   ///< Nogoods learned
+    uint64_t _backjumps{ 0 }; ///< Failures skipping the rows left at their level
+    uint64_t _pruned{ 0 };    ///< Rows skipped for completing a known nogood
+};
+
+/*!
+ * \brief Bounds are the largest values the solutions to a problem may hold, to size their storage
+ * (\see SolutionWriter)
+ */
+struct Bounds
+{
+    uint64_t _rows{ 0 };    ///< Rows of a solution
+    uint64_t _largest{ 0 }; ///< Row identifiers, in absolute value
+};
+
+/*!
+ * \brief SolveOptions are the parameters of an asynchronous search (\see DLX::solve_async)
+ */
+struct SolveOptions
+{
+    uint64_t _maxSolutions{ std::numeric_limits<uint64_t>::max() }; ///< Solutions to look for
+    bool     _keep{ true }; ///< Keep the solutions to be polled, or only count them
+};
+
 /*!
  * \brief The LatinSquares class is the DLX implementation of an exact cover problem
  * \see https://arxiv.org/pdf/cs/0011047v1.pdf for more informations about
@@ -36,17 +165,198 @@ class DLX
 protected:
     struct Solution
     { ///< A solution is a combinaison of rows
-        explicit Solution(const std::vector<int>& data) noexcept
-          : _d{ data }
+        using allocator_type = std::pmr::polymorphic_allocator<int>;
+
+        template<typename Rows, typename = std::enable_if_t<!std::is_same_v<Rows, Solution>>>
+        explicit Solution(const Rows& data, const allocator_type& alloc = {}) noexcept
+          : _d(std::begin(data), std::end(data), alloc)
+        {}
+        Solution(const Solution& other, const allocator_type& alloc) noexcept
+          : _d(other._d, alloc)
         {}
 
-        const std::vector<int> _d;
+        const std::pmr::vector<int> _d;
     };
 
 public:
-    virtual std::vector<Solution> solve(
+    /*!
+     * \brief Visitor is given the row identifiers of every solution, as soon as it is found
+     */
+    using Visitor = std::function<void(const std::pmr::vector<int>& rows)>;
+
+    /*!
+     * \brief The AsyncSolve class is the handle of a search running on its own thread
+     * (\see solve_async). Dropping it cancels the search, and releases its memory.
+     * A moved-from handle is that of a search over, without any solution.
+     */
+    class AsyncSolve
+    {
+    public:
+        struct Progress
+        {
+            uint64_t _nodes{ 0 };     ///< Nodes of the search tree explored so far
+            uint64_t _solutions{ 0 }; ///< Solutions found so far
+            bool     _done{ false };  ///< Is the search over (complete or cancelled)
+        };
+
+    public:
+        AsyncSolve(AsyncSolve&&) noexcept;
+        AsyncSolve& operator=(AsyncSolve&&) noexcept;
+        ~AsyncSolve() noexcept;
+
+        /*!
+         * \brief wait Wait for the end of the search
+         */
+        void wait(void) const noexcept;
+
+        /*!
+         * \brief wait_for Wait for the end of the search, at most \a timeout
+         * \return true if the search is over
+         */
+        bool wait_for(std::chrono::nanoseconds timeout) const noexcept;
+
+        /*!
+         * \brief done Is the search over (complete or cancelled)
+         */
+        bool done(void) const noexcept;
+
+        /*!
+         * \brief progress Get the counters of the search. The nodes are updated every 1024 of
+         * them, and at the end of the search.
+         */
+        Progress progress(void) const noexcept;
+
+        /*!
+         * \brief poll Take the solutions found since the previous call
+         * \return The row identifiers of the solutions (\see ConcreteProblem::apply)
+         */
+        std::vector<std::vector<int>> poll(void) noexcept;
+
+        /*!
+         * \brief cancel Stop the search as soon as possible. The solutions found so far can still
+         * be polled.
+         */
+        void cancel(void) noexcept;
+
+    private:
+        friend class DLX;
+        AsyncSolve() noexcept;
+
+        struct Impl;
+        std::unique_ptr<Impl> pimpl{ nullptr };
+    };
+
+public:
+    /*!
+     * \brief solve Solve the problem
+     * \param max_solutions The maximum number of solutions to look for
+     * \return The solutions found, allocated from the memory resource of the problem
+     */
+    virtual std::pmr::vector<Solution> solve(
       uint32_t max_solutions = std::numeric_limits<uint32_t>::max()) noexcept;
 
+    /*!
+     * \brief count Count the solutions to the problem, without keeping them
+     * \param max_solutions The maximum number of solutions to look for
+     * \return The number of solutions found
+     */
+    virtual uint64_t count(uint64_t max_solutions = std::numeric_limits<uint64_t>::max()) noexcept;
+
+    /*!
+     * \brief enumerate Solve the problem without keeping the solutions : each one is given to a
+     * visitor straight from the search (\see SolutionWriter to stream them to a file)
+     * \param f The visitor. The rows it is given are only valid during the call.
+     * It may stop the search (\see stop), as a \a SolutionWriter visitor does when it fails to
+     * write a solution.
+     * \param max_solutions The maximum number of solutions to look for
+     * \return The number of solutions found
+     */
+    virtual uint64_t enumerate(
+      const Visitor& f,
+      uint64_t       max_solutions = std::numeric_limits<uint64_t>::max()) noexcept;
+
+    /*!
+     * \brief stop Stop the search of \a enumerate : it returns once the visitor does.
+     * It must only be called by the visitor, and has no effect from anywhere else.
+     */
+    void stop() noexcept;
+
+    /*!
+     * \brief bounds Get the largest values the solutions to the problem may hold : the rows of a
+     * solution cover distinct primary columns (as many as the narrowest row at least)
+     */
+    Bounds bounds() const noexcept;
+
+    /*!
+     * \brief solve_async Solve the problem on a thread of its own, with the dancing links engine
+     * (learning from its failures if \a Engine::Learning is selected).
+     * Until the search is over, the other searches of the problem (\a solve, \a count,
+     * \a enumerate, \a estimate...) and its \a set_engine and \a set_layout are refused : they
+     * find nothing, or return false. The problem may be destroyed though, the search keeping its
+     * nodes alive, but not its memory resource.
+     * \param options The parameters of the search
+     * \return The handle of the search, to wait for it, poll its solutions, or cancel it. It is
+     * over at once, without any solution, if another search runs on the problem.
+     */
+    AsyncSolve solve_async(const SolveOptions& options = {}) noexcept;
+
+    /*!
+     * \brief count_memoized Count every solution to the problem, caching the number of solutions
+     * of every sub-problem (identified by its set of remaining columns). Sub-problems reached
+     * through different rows orderings are then only solved once.
+     * It always uses the dancing links engine.
+     * \param max_memory The memory bound (in bytes) of the cache. Once reached, new sub-problems
+     * are not cached anymore.
+     * \return The number of solutions (saturated to UINT64_MAX)
+     */
+    uint64_t count_memoized(size_t max_memory = size_t{ 256 } << 20) noexcept;
+
+    /*!
+     * \brief zdd Build a compressed representation of every solution to the problem, following
+     * Knuth's DXZ algorithm : the diagrams of the sub-problems are cached like in
+     * \a count_memoized, and shared.
+     * \param max_memory The memory bound (in bytes) of the sub-problems cache
+     * \return The diagram of the solutions
+     */
+    Zdd zdd(size_t max_memory = size_t{ 256 } << 20) noexcept;
+
+    /*!
+     * \brief estimate Predict the cost of a complete search without running it, following
+     * Knuth's random probes : every probe walks down a random path of the search tree (using the
+     * same column choices as \a solve), and weighs each level by the product of the branching
+     * factors above it. Those weights are unbiased estimates of the search tree size.
+     * It always uses the dancing links engine, whose cost per node is timed on the first call.
+     * \param probes The number of random paths to walk
+     * \param seed The seed of the random rows choices
+     * \return The estimated number of nodes and solutions, and the time to find them all
+     */
+    Estimate estimate(uint32_t probes = 1000, uint64_t seed = 0) noexcept;
+
+    /*!
+     * \brief set_engine Select the algorithm used by \a solve and \a count
+     * \return false if the problem cannot be solved by \a engine (the engine is left unchanged)
+     */
+    virtual bool set_engine(Engine engine) noexcept;
+    Engine       engine() const noexcept { return _engine; }
+
+    /*!
+     * \brief learning Get the work done by the last search of the \a Engine::Learning engine
+     * (to compare its nodes with the ones of \a Engine::Links, \see AsyncSolve::progress)
+     */
+    Learning learning() const noexcept;
+
+    /*!
+     * \brief set_layout Lay the nodes of the dancing links engine out again in memory
+     * \return false if the problem is empty (the layout is left unchanged)
+     */
+    bool   set_layout(Layout layout) noexcept;
+    Layout layout() const noexcept { return _layout; }
+
+    /*!
+     * \brief resource Get the memory resource every structure of the problem is allocated from
+     */
+    std::pmr::memory_resource* resource() const noexcept;
+
 protected:
     /*!
      * \brief DLX Create a DLX algorithm
@@ -58,18 +368,35 @@ protected:
      * By default, every constraint is primary (meaning it has to be satisfied exactly once)
      * Columns past \a primary index will be considered as 'secondary' (meaning the can be left
      * unsatisfied)
+     * \param resource The memory resource to allocate the problem from
+     */
+    DLX(const std::vector<bool>&     data,
+        size_t                       rows,
+        size_t                       cols,
+        const std::pmr::vector<int>& rowsList,
+        int                          primary,
+        std::pmr::memory_resource*   resource) noexcept;
+    /*!
+     * \brief DLX Create a DLX algorithm from a sparse adjacency matrix
+     * \param m The adjacency matrix
+     * \param rowsList The list of row identifiers (usefull to parse problem state from solutions)
+     * \param resource The memory resource to allocate the problem from
      */
-    DLX(const std::vector<bool>& data,
-        size_t                   rows,
-        size_t                   cols,
-        const std::vector<int>&  rowsList,
-        int                      primary = -1)
-    noexcept;
+    DLX(const SparseMatrix&          m,
+        const std::pmr::vector<int>& rowsList,
+        std::pmr::memory_resource*   resource) noexcept;
     virtual ~DLX() noexcept = default;
 
+    /*!
+     * \brief use_engine Record the engine selected by \a set_engine (or by its overrides)
+     */
+    void use_engine(Engine engine) noexcept;
+
 protected:
     struct Impl;
     std::shared_ptr<Impl> pimpl{ nullptr };
+    Engine                _engine{ Engine::Links };
+    Layout                _layout{ Layout::Input };
 };
 
 /*!
@@ -87,15 +414,80 @@ public:
      * \param rows The number of rows in \a data
      * \param cols The number of columns in \a data
      * \param primary The number of primary (i.e. essentials) constraints
+     * \param resource The memory resource to allocate the problem from
      * \return A generic exact cover problem in case of success, nullptr otherwise
      */
-    static std::unique_ptr<GenericProblem> generate(const std::vector<bool>& data,
-                                                    size_t                   rows,
-                                                    size_t                   cols,
-                                                    int                      primary = -1) noexcept;
+    static std::unique_ptr<GenericProblem> generate(
+      const std::vector<bool>&   data,
+      size_t                     rows,
+      size_t                     cols,
+      int                        primary = -1,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept;
+
+    /*!
+     * \brief generate Allows to create a generic exact cover problem from a sparse adjacency
+     * matrix. Prefer it to the dense version for large problems.
+     * \param m A sparse adjacency matrix
+     * \param resource The memory resource to allocate the problem from
+     * \return A generic exact cover problem in case of success, nullptr otherwise
+     */
+    static std::unique_ptr<GenericProblem> generate(
+      const SparseMatrix&        m,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept;
+
+    /*!
+     * \brief load Create a generic exact cover problem from a binary cover file.
+     * The file is memory-mapped, so that its CSR arrays are used without being parsed.
+     *
+     * Binary layout (native endianness) :
+     *  - char[4]  magic "ECVX"
+     *  - uint32_t version (1)
+     *  - uint64_t rows, uint64_t cols
+     *  - int64_t  primary (-1 means every column)
+     *  - uint64_t nnz (number of non-zero entries)
+     *  - uint64_t offsets[rows + 1]
+     *  - uint32_t indices[nnz]
+     *
+     * \param path The path of the file
+     * \param resource The memory resource to allocate the problem from
+     * \return A generic exact cover problem in case of success, nullptr otherwise
+     */
+    static std::unique_ptr<GenericProblem> load(
+      const std::string&         path,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept;
+
+    /*!
+     * \brief save Write a sparse adjacency matrix as a binary cover file (\see load).
+     * \param path The path of the file
+     * \param m The sparse adjacency matrix
+     * \return true in case of success, false otherwise
+     */
+    static bool save(const std::string& path, const SparseMatrix& m) noexcept;
+
+    /*!
+     * \brief parse Create a generic exact cover problem from the text format used by other DLX
+     * solvers. The input is read as a stream, one line at a time :
+     *  - lines starting with '|' are comments
+     *  - the first line lists the item (column) names. Items placed after a '|' are secondary
+     *  - every following line is an option (row), given as a list of item names
+     *
+     * Rows ids in solutions are the indexes of the options in the input.
+     *
+     * \param in The input stream
+     * \param resource The memory resource to allocate the problem from
+     * \return A generic exact cover problem in case of success, nullptr otherwise
+     */
+    static std::unique_ptr<GenericProblem> parse(
+      std::istream&              in,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept;
 
 protected:
-    GenericProblem(const std::vector<bool>& data, size_t rows, size_t cols, int primary) noexcept;
+    GenericProblem(const std::vector<bool>&   data,
+                   size_t                     rows,
+                   size_t                     cols,
+                   int                        primary,
+                   std::pmr::memory_resource* resource) noexcept;
+    GenericProblem(const SparseMatrix& m, std::pmr::memory_resource* resource) noexcept;
 };
 
 /*!
@@ -111,12 +503,16 @@ public:
      */
     virtual State apply(const Solution& s) noexcept = 0;
 
+    /*!
+     * \brief apply Same as \a apply, from the row identifiers of a solution (as given to a
+     * \a DLX::Visitor, or read back by a \a SolutionReader)
+     */
+    State apply(const std::vector<int>& rows) noexcept { return apply(Solution{ rows }); }
+
 protected:
-    ConcreteProblem(const std::vector<bool>& data,
-                    size_t                   rows,
-                    size_t                   cols,
-                    const std::vector<int>&  rowsList,
-                    int                      primary = -1) noexcept;
+    ConcreteProblem(const SparseMatrix&          m,
+                    const std::pmr::vector<int>& rowsList,
+                    std::pmr::memory_resource*   resource) noexcept;
     virtual ~ConcreteProblem() noexcept = default;
 };
 
@@ -136,23 +532,46 @@ public:
      * exact cover problem.
      * \param state a String representation of the problem as a grid.
      * Use '0' to represent non-constrained cells
+     * \param resource The memory resource to allocate the problem from
+     * \return A "Latin square" exact cover problem pointer in case of success, nullptr otherwise
+     */
+    static std::unique_ptr<LatinSquares> generate(
+      const State&               state = make_empty_state(),
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept;
+
+    /*!
+     * \brief parse Same as \a generate, from a single-line representation of the grid.
+     * \param grid The N * N cells of the grid, row after row.
+     * Use '0' or '.' to represent non-constrained cells
+     * \param resource The memory resource to allocate the problem from
      * \return A "Latin square" exact cover problem pointer in case of success, nullptr otherwise
      */
-    static std::unique_ptr<LatinSquares> generate(const State& state = make_empty_state()) noexcept;
+    static std::unique_ptr<LatinSquares> parse(
+      std::string_view           grid,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept;
 
+    using ConcreteProblem::apply;
     State apply(const Solution& s) noexcept override;
 
+    /*!
+     * \brief apply Same as \a apply, using the single-line representation of the grid.
+     * \param s a solution (given by 'DLX::solve()')
+     * \param grid Filled with the N * N cells of the solved grid, row after row
+     */
+    void apply(const Solution& s, std::string& grid) const noexcept;
+
     virtual ~LatinSquares() noexcept = default;
 
 protected:
-    LatinSquares(const std::vector<bool>& data,
-                 size_t                   rows,
-                 size_t                   cols,
-                 const std::vector<int>&  rowsList,
-                 const State&             initStata) noexcept;
+    LatinSquares(const SparseMatrix&          m,
+                 const std::pmr::vector<int>& rowsList,
+                 std::string_view             initGrid,
+                 size_t                       dim,
+                 std::pmr::memory_resource*   resource) noexcept;
 
 private:
-    const State _initState;
+    const std::pmr::string _initGrid;
+    const size_t           _dim;
 };
 
 /*!
@@ -170,23 +589,44 @@ public:
      * exact cover problem.
      * \param state a String representation of the problem as a grid.
      * Use '0' to represent non-constrained cells
+     * \param resource The memory resource to allocate the problem from
+     * \return A "Sudoku" exact cover problem pointer in case of success, nullptr otherwise
+     */
+    static std::unique_ptr<Sudoku> generate(
+      const State&               state = make_empty_state(),
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept;
+
+    /*!
+     * \brief parse Same as \a generate, from the usual 81 characters representation of a sudoku.
+     * \param grid The 81 cells of the grid, row after row.
+     * Use '0' or '.' to represent non-constrained cells
+     * \param resource The memory resource to allocate the problem from
      * \return A "Sudoku" exact cover problem pointer in case of success, nullptr otherwise
      */
-    static std::unique_ptr<Sudoku> generate(const State& state = make_empty_state()) noexcept;
+    static std::unique_ptr<Sudoku> parse(
+      std::string_view           grid,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept;
 
+    using ConcreteProblem::apply;
     State apply(const Solution& s) noexcept override;
 
+    /*!
+     * \brief apply Same as \a apply, using the 81 characters representation of the grid.
+     * \param s a solution (given by 'DLX::solve()')
+     * \param grid Filled with the 81 cells of the solved grid, row after row
+     */
+    void apply(const Solution& s, std::string& grid) const noexcept;
+
     virtual ~Sudoku() noexcept = default;
 
 protected:
-    Sudoku(const std::vector<bool>& data,
-           size_t                   rows,
-           size_t                   cols,
-           const std::vector<int>&  rowsList,
-           const State&             initStata) noexcept;
+    Sudoku(const SparseMatrix&          m,
+           const std::pmr::vector<int>& rowsList,
+           std::string_view             initGrid,
+           std::pmr::memory_resource*   resource) noexcept;
 
 private:
-    const State _initState;
+    const std::pmr::string _initGrid;
 };
 
 /*!
@@ -205,24 +645,45 @@ public:
      * \param state a String representation of the problem as a grid.
      * Use '0' to represent non-constrained (i.e. empty) cells, everything else for a cell with a
      * Queen.
+     * \param resource The memory resource to allocate the problem from
      * \return A "N Queens" exact cover problem pointer in case of success, nullptr otherwise
+     * (as when pre-placed queens attack each other)
      */
-    static std::unique_ptr<NQueens> generate(const State& state = make_empty_state()) noexcept;
+    static std::unique_ptr<NQueens> generate(
+      const State&               state = make_empty_state(),
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept;
 
+    using ConcreteProblem::apply;
     State apply(const Solution& s) noexcept override;
 
+    std::pmr::vector<Solution> solve(
+      uint32_t max_solutions = std::numeric_limits<uint32_t>::max()) noexcept override;
+    uint64_t count(uint64_t max_solutions = std::numeric_limits<uint64_t>::max()) noexcept override;
+    uint64_t enumerate(
+      const Visitor& f,
+      uint64_t       max_solutions = std::numeric_limits<uint64_t>::max()) noexcept override;
+
+    /*!
+     * \brief set_engine Select the algorithm used by \a solve and \a count.
+     * NQueens also supports \a Engine::Bitboard (for boards up to 64 * 64), which solves the
+     * problem row by row using bitmasks, in parallel over the placements of the first free row,
+     * and only explores half of them when the pre-placed queens are mirror-symmetric.
+     * It gives the same solutions as the DLX algorithm, possibly in another order.
+     */
+    bool set_engine(Engine engine) noexcept override;
+
     virtual ~NQueens() noexcept = default;
 
 protected:
-    NQueens(const std::vector<bool>& data,
-            size_t                   rows,
-            size_t                   cols,
-            const std::vector<int>&  rowsList,
-            const State&             initStata,
-            int                      primary) noexcept;
+    NQueens(const SparseMatrix&          m,
+            const std::pmr::vector<int>& rowsList,
+            std::string_view             initGrid,
+            size_t                       dim,
+            std::pmr::memory_resource*   resource) noexcept;
 
 private:
-    const State _initState;
+    const std::pmr::string _initGrid; // The N * N cells of the initial board, row after row
+    const size_t           _dim;
 };
 
 } // namespace ecv
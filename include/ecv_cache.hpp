@@ -0,0 +1,87 @@
+/**
+ * @file ecv_cache.hpp
+ * @brief Results cache of equivalent puzzles
+ * @author lhm
+ */
+
+#ifndef INCLUDE_ECV_CACHE_HPP
+#define INCLUDE_ECV_CACHE_HPP
+
+// Project's headers
+#include <ecv.hpp>
+
+namespace ecv {
+
+/*!
+ * \brief The ResultCache class solves puzzles (\a Sudoku or \a LatinSquares) through a bounded
+ * LRU cache of the solutions of their canonical forms.
+ *
+ * Puzzles equivalent up to digits relabeling, rows and columns permutations (keeping the bands
+ * and stacks of a sudoku) and transposition share the same canonical form : the smallest grid,
+ * read row after row, among the relabeled transformations of the puzzle. On a hit, the cached
+ * solutions are mapped back through the transformation, so that only canonicalization is paid.
+ *
+ * The solutions are those of the canonical puzzle : when a puzzle has more than
+ * \a max_solutions of them, the ones returned may differ from a direct \a solve, and come in
+ * another order. Puzzles whose canonical form is too long to find (such as almost empty grids,
+ * having many automorphisms) are solved directly, without going through the cache.
+ * It can be shared between threads.
+ */
+template<typename Problem>
+class ResultCache
+{
+public:
+    struct Stats
+    {
+        uint64_t _hits{ 0 };     ///< Puzzles whose solutions were found in the cache
+        uint64_t _misses{ 0 };   ///< Puzzles solved, then cached
+        uint64_t _bypassed{ 0 }; ///< Puzzles solved directly (invalid, or too symmetric)
+        size_t   _size{ 0 };     ///< Canonical forms in the cache
+    };
+
+public:
+    /*!
+     * \brief ResultCache Create an empty cache
+     * \param capacity The maximum number of canonical forms kept
+     * \param max_solutions The maximum number of solutions to look for (and keep) per puzzle
+     */
+    explicit ResultCache(size_t capacity = 4096, uint32_t max_solutions = 2) noexcept;
+    ~ResultCache() noexcept;
+
+    ResultCache(const ResultCache&) = delete;
+    ResultCache& operator=(const ResultCache&) = delete;
+
+    /*!
+     * \brief solve Solve a puzzle, going through the cache
+     * \param grid The cells of the puzzle, row after row (\see Problem::parse)
+     * \return The solved grids, row after row (none if \a grid is invalid)
+     */
+    std::vector<std::string> solve(std::string_view grid) noexcept;
+
+    /*!
+     * \brief solve Same as \a solve, from the state of a puzzle (\see Problem::generate)
+     * \return The states of the solutions (none if \a state is invalid)
+     */
+    std::vector<State> solve(const State& state) noexcept;
+
+    /*!
+     * \brief stats Get the number of hits and misses since the creation of the cache
+     */
+    Stats stats(void) const noexcept;
+
+    /*!
+     * \brief clear Remove every canonical form from the cache
+     */
+    void clear(void) noexcept;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pimpl{ nullptr };
+};
+
+extern template class ResultCache<Sudoku>;
+extern template class ResultCache<LatinSquares>;
+
+} // namespace ecv
+
+#endif // INCLUDE_ECV_CACHE_HPP
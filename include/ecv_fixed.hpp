@@ -0,0 +1,595 @@
+/**
+ * @file ecv_fixed.hpp
+ * @brief Compile-time specialized exact cover problems of the ecv library
+ * @author lhm
+ */
+
+#ifndef INCLUDE_ECV_FIXED_HPP
+#define INCLUDE_ECV_FIXED_HPP
+
+// Project's headers
+#include <ecv.hpp>
+
+// Standard headers
+#include <array>
+#include <optional>
+#include <type_traits>
+
+namespace ecv {
+
+/*!
+ * \brief The \a fixed namespace holds exact cover problems whose dimensions are known at compile
+ * time. Their constraint layout is computed as a constant expression, and their nodes live in
+ * fixed-size arrays : creating one of them never allocates, and the solver loop is bounded at
+ * compile time.
+ */
+namespace fixed {
+
+/*!
+ * \brief The Links class is a DLX implementation for an adjacency matrix of \a Rows rows having
+ * exactly \a Width non-zero entries each, among \a Cols columns. The \a Primary first columns
+ * are primary ones, the others are secondary. A solution is made of at most \a Depth rows.
+ */
+template<size_t Rows, size_t Cols, size_t Width, size_t Primary = Cols, size_t Depth = Primary>
+class Links
+{
+public:
+    static constexpr size_t NODES{ Cols + 1 + Rows * Width }; ///< Headers (root first) and entries
+
+    using index_t = std::conditional_t<(NODES < 0xFFFF), uint16_t, uint32_t>;
+    using Layout = std::array<std::array<index_t, Width>, Rows>; ///< Columns of every row
+
+    struct Solution
+    { ///< A solution is a combinaison of rows
+        std::array<uint32_t, Depth> _d{};
+        size_t                      _size{ 0 };
+    };
+
+    /*!
+     * \brief solve Enumerate the solutions to the problem
+     * \param f Called with every solution (as a 'const Solution&')
+     * \param max_solutions The maximum number of solutions to look for
+     * \return The number of solutions found
+     */
+    template<typename F, typename = std::enable_if_t<std::is_invocable_v<F, const Solution&>>>
+    size_t solve(F&& f, size_t max_solutions = std::numeric_limits<size_t>::max()) noexcept;
+
+    /*!
+     * \brief solve Get (at most \a max_solutions) solutions to the problem
+     */
+    std::vector<Solution> solve(size_t max_solutions = std::numeric_limits<size_t>::max())
+    {
+        std::vector<Solution> ret{};
+        solve([&ret](const Solution& s) { ret.push_back(s); }, max_solutions);
+        return ret;
+    }
+
+    /*!
+     * \brief count Count (at most \a max_solutions) solutions to the problem
+     */
+    size_t count(size_t max_solutions = std::numeric_limits<size_t>::max()) noexcept
+    {
+        return solve([](const Solution&) {}, max_solutions);
+    }
+
+protected:
+    struct Node
+    {
+        index_t _l, _r, _u, _d, _c;
+    };
+
+    struct Arena
+    {
+        std::array<Node, NODES>       _nodes{};
+        std::array<index_t, Cols + 1> _size{};
+        std::array<bool, Cols + 1>    _covered{};
+    };
+
+    /*!
+     * \brief build Build the initial nodes of the adjacency matrix described by \a layout.
+     * Secondary columns are not linked to the root, so that they never get selected.
+     */
+    static constexpr Arena build(const Layout& layout) noexcept
+    {
+        Arena a{};
+        for (size_t c{ 0 }; c <= Cols; ++c) {
+            auto h{ static_cast<index_t>(c) };
+            a._nodes[c] = Node{ h, h, h, h, h };
+        }
+
+        for (size_t c{ 0 }; c <= Primary; ++c) {
+            a._nodes[c]._r = static_cast<index_t>((Primary == c) ? 0 : c + 1);
+            a._nodes[c]._l = static_cast<index_t>((0 == c) ? Primary : c - 1);
+        }
+
+        for (size_t r{ 0 }; r < Rows; ++r) {
+            auto first{ Cols + 1 + r * Width };
+            for (size_t w{ 0 }; w < Width; ++w) {
+                auto x{ static_cast<index_t>(first + w) };
+                auto c{ static_cast<index_t>(layout[r][w] + 1) };
+                auto u{ a._nodes[c]._u };
+
+                a._nodes[x] = Node{ static_cast<index_t>((0 == w) ? first + Width - 1 : x - 1),
+                                    static_cast<index_t>((Width - 1 == w) ? first : x + 1),
+                                    u,
+                                    c,
+                                    c };
+                a._nodes[u]._d = x;
+                a._nodes[c]._u = x;
+                ++a._size[c];
+            }
+        }
+
+        return a;
+    }
+
+    explicit Links(const Arena& initial) noexcept
+      : _a{ initial }
+    {}
+
+    /*!
+     * \brief select Select a row before solving (pre-placed pieces, givens...)
+     * \return false if the row conflicts with an already selected one
+     */
+    bool select(size_t row) noexcept
+    {
+        auto first{ static_cast<index_t>(Cols + 1 + row * Width) };
+        for (size_t w{ 0 }; w < Width; ++w)
+            if (_a._covered[_a._nodes[first + w]._c])
+                return false;
+
+        for (size_t w{ 0 }; w < Width; ++w)
+            cover(_a._nodes[first + w]._c);
+        return true;
+    }
+
+private:
+    static constexpr size_t row(index_t x) noexcept { return (x - Cols - 1) / Width; }
+
+    void cover(index_t c) noexcept
+    {
+        auto& n{ _a._nodes };
+        n[n[c]._l]._r = n[c]._r;
+        n[n[c]._r]._l = n[c]._l;
+        _a._covered[c] = true;
+
+        for (auto i{ n[c]._d }; c != i; i = n[i]._d) {
+            for (auto j{ n[i]._r }; i != j; j = n[j]._r) {
+                n[n[j]._u]._d = n[j]._d;
+                n[n[j]._d]._u = n[j]._u;
+                --_a._size[n[j]._c];
+            }
+        }
+    }
+
+    void uncover(index_t c) noexcept
+    {
+        auto& n{ _a._nodes };
+        for (auto i{ n[c]._u }; c != i; i = n[i]._u) {
+            for (auto j{ n[i]._l }; i != j; j = n[j]._l) {
+                ++_a._size[n[j]._c];
+                n[n[j]._u]._d = j;
+                n[n[j]._d]._u = j;
+            }
+        }
+
+        _a._covered[c] = false;
+        n[n[c]._l]._r = c;
+        n[n[c]._r]._l = c;
+    }
+
+    void commit(index_t x) noexcept
+    {
+        for (auto j{ _a._nodes[x]._r }; x != j; j = _a._nodes[j]._r)
+            cover(_a._nodes[j]._c);
+    }
+
+    void uncommit(index_t x) noexcept
+    {
+        for (auto j{ _a._nodes[x]._l }; x != j; j = _a._nodes[j]._l)
+            uncover(_a._nodes[j]._c);
+    }
+
+    index_t col_select() const noexcept
+    {
+        auto ret{ _a._nodes[0]._r };
+        for (auto c{ _a._nodes[ret]._r }; 0 != c; c = _a._nodes[c]._r)
+            if (_a._size[c] < _a._size[ret])
+                ret = c;
+        return ret;
+    }
+
+private:
+    Arena _a;
+};
+
+/*****************************************************************************/
+template<size_t Rows, size_t Cols, size_t Width, size_t Primary, size_t Depth>
+template<typename F, typename>
+size_t
+Links<Rows, Cols, Width, Primary, Depth>::solve(F&& f, size_t max_solutions) noexcept
+{
+    // Iterative version of the recursive dance, bounded by the depth of the solutions
+    std::array<index_t, Depth + 1> x{};
+    Solution                       sol{};
+    size_t                         level{ 0 }, count{ 0 };
+    bool                           forward{ true };
+
+    if (0 == max_solutions)
+        return 0;
+
+    while (true) {
+        if (forward) {
+            if (0 == _a._nodes[0]._r) { // success
+                sol._size = level;
+                for (size_t i{ 0 }; i < level; ++i)
+                    sol._d[i] = row(x[i]);
+                f(static_cast<const Solution&>(sol));
+                forward = false;
+
+                if (max_solutions == ++count) { // Leave the matrix as it was
+                    while (0 != level--) {
+                        uncommit(x[level]);
+                        uncover(_a._nodes[x[level]]._c);
+                    }
+                    break;
+                }
+            } else {
+                auto c{ col_select() };
+                cover(c);
+                x[level] = _a._nodes[c]._d;
+            }
+        }
+
+        if (!forward) {
+            if (0 == level)
+                break;
+            --level;
+            uncommit(x[level]);
+            x[level] = _a._nodes[x[level]]._d;
+        }
+
+        if (x[level] <= Cols) { // Every row of the column has been tried
+            uncover(x[level]);
+            forward = false;
+            continue;
+        }
+
+        commit(x[level]);
+        ++level;
+        forward = true;
+    }
+
+    return count;
+}
+
+/*!
+ * \brief The Sudoku class is the compile-time version of \a ecv::Sudoku, for grids made of
+ * \a B * \a B areas of \a B * \a B cells. Row ids of solutions match the ones of \a ecv::Sudoku.
+ */
+template<size_t B>
+class Sudoku
+  : public Links<B * B * B * B * B * B, 4 * B * B * B * B, 4, 4 * B * B * B * B, B * B * B * B>
+{
+    static constexpr size_t N{ B * B };
+    using Base = Links<N * N * N, 4 * N * N, 4, 4 * N * N, N * N>;
+
+public:
+    using typename Base::Layout;
+    using typename Base::Solution;
+
+    /*!
+     * \brief layout The constraints of every placement (placing a number in a cell) :
+     * 1 number per cell, each number once per row, per col and per area
+     */
+    static constexpr Layout layout() noexcept
+    {
+        Layout ret{};
+        for (size_t i{ 0 }; i < N; ++i)
+            for (size_t j{ 0 }; j < N; ++j)
+                for (size_t k{ 0 }; k < N; ++k)
+                    ret[i * N * N + j * N + k] = { static_cast<typename Base::index_t>(i * N + j),
+                                                   static_cast<typename Base::index_t>(
+                                                     N * N + i * N + k),
+                                                   static_cast<typename Base::index_t>(
+                                                     2 * N * N + j * N + k),
+                                                   static_cast<typename Base::index_t>(
+                                                     3 * N * N + (B * (i / B) + (j / B)) * N + k) };
+        return ret;
+    }
+
+    /*!
+     * \brief parse Create the problem from the N * N cells of the grid, row after row.
+     * Use '0' or '.' to represent non-constrained cells
+     * \return The problem in case of success, std::nullopt otherwise
+     */
+    static std::optional<Sudoku> parse(std::string_view grid) noexcept
+    {
+        if (N * N != std::size(grid))
+            return std::nullopt;
+
+        std::optional<Sudoku> ret{ Sudoku{} };
+        for (size_t p{ 0 }; p < N * N; ++p) {
+            auto val{ ('.' == grid[p]) ? 0 : grid[p] - '0' };
+            if (0 > val || static_cast<int>(N) < val)
+                return std::nullopt;
+            if (0 == val)
+                continue;
+
+            ret->_initGrid[p] = grid[p];
+            if (!ret->select(p * N + val - 1))
+                return std::nullopt;
+        }
+        return ret;
+    }
+
+    /*!
+     * \brief generate Create the problem from its grid representation (\see ecv::Sudoku)
+     * \return The problem in case of success, std::nullopt otherwise
+     */
+    static std::optional<Sudoku> generate(const State& state) noexcept
+    {
+        std::array<char, N * N> grid{};
+        if (N != std::size(state))
+            return std::nullopt;
+        for (size_t i{ 0 }; i < N; ++i) {
+            if (N != std::size(state[i]))
+                return std::nullopt;
+            std::copy(std::begin(state[i]), std::end(state[i]), std::begin(grid) + i * N);
+        }
+        return parse(std::string_view{ grid.data(), N * N });
+    }
+
+    /*!
+     * \brief apply Get the N * N cells of the grid when applying a solution to it.
+     */
+    void apply(const Solution& s, std::string& grid) const
+    {
+        grid.assign(_initGrid.data(), N * N);
+        for (size_t i{ 0 }; i < s._size; ++i)
+            grid[s._d[i] / N] = (s._d[i] % N) + '1';
+    }
+
+    /*!
+     * \brief apply Get the state of the problem when applying a solution to it.
+     */
+    State apply(const Solution& s) const
+    {
+        std::string grid{};
+        apply(s, grid);
+
+        State ret{};
+        for (size_t i{ 0 }; i < N; ++i)
+            ret.emplace_back(grid, i * N, N);
+        return ret;
+    }
+
+private:
+    static constexpr typename Base::Arena ARENA{ Base::build(layout()) };
+
+    Sudoku() noexcept
+      : Base{ ARENA }
+    {
+        _initGrid.fill('0');
+    }
+
+    std::array<char, N * N> _initGrid;
+};
+
+/*!
+ * \brief The LatinSquares class is the compile-time version of \a ecv::LatinSquares, for grids of
+ * \a N * \a N cells. Row ids of solutions match the ones of \a ecv::LatinSquares.
+ */
+template<size_t N>
+class LatinSquares : public Links<N * N * N, 3 * N * N, 3, 3 * N * N, N * N>
+{
+    using Base = Links<N * N * N, 3 * N * N, 3, 3 * N * N, N * N>;
+
+public:
+    using typename Base::Layout;
+    using typename Base::Solution;
+
+    /*!
+     * \brief layout The constraints of every placement (placing a number in a cell) :
+     * 1 number per cell, each number once per row and per col
+     */
+    static constexpr Layout layout() noexcept
+    {
+        Layout ret{};
+        for (size_t i{ 0 }; i < N; ++i)
+            for (size_t j{ 0 }; j < N; ++j)
+                for (size_t k{ 0 }; k < N; ++k)
+                    ret[i * N * N + j * N + k] = {
+                        static_cast<typename Base::index_t>(i * N + j),
+                        static_cast<typename Base::index_t>(N * N + i * N + k),
+                        static_cast<typename Base::index_t>(2 * N * N + j * N + k)
+                    };
+        return ret;
+    }
+
+    /*!
+     * \brief parse Create the problem from the N * N cells of the grid, row after row.
+     * Use '0' or '.' to represent non-constrained cells
+     * \return The problem in case of success, std::nullopt otherwise
+     */
+    static std::optional<LatinSquares> parse(std::string_view grid) noexcept
+    {
+        if (N * N != std::size(grid))
+            return std::nullopt;
+
+        std::optional<LatinSquares> ret{ LatinSquares{} };
+        for (size_t p{ 0 }; p < N * N; ++p) {
+            auto val{ ('.' == grid[p]) ? 0 : grid[p] - '0' };
+            if (0 > val || static_cast<int>(N) < val)
+                return std::nullopt;
+            if (0 == val)
+                continue;
+
+            ret->_initGrid[p] = grid[p];
+            if (!ret->select(p * N + val - 1))
+                return std::nullopt;
+        }
+        return ret;
+    }
+
+    /*!
+     * \brief generate Create the problem from its grid representation (\see ecv::LatinSquares)
+     * \return The problem in case of success, std::nullopt otherwise
+     */
+    static std::optional<LatinSquares> generate(const State& state) noexcept
+    {
+        std::array<char, N * N> grid{};
+        if (N != std::size(state))
+            return std::nullopt;
+        for (size_t i{ 0 }; i < N; ++i) {
+            if (N != std::size(state[i]))
+                return std::nullopt;
+            std::copy(std::begin(state[i]), std::end(state[i]), std::begin(grid) + i * N);
+        }
+        return parse(std::string_view{ grid.data(), N * N });
+    }
+
+    /*!
+     * \brief apply Get the N * N cells of the grid when applying a solution to it.
+     */
+    void apply(const Solution& s, std::string& grid) const
+    {
+        grid.assign(_initGrid.data(), N * N);
+        for (size_t i{ 0 }; i < s._size; ++i)
+            grid[s._d[i] / N] = (s._d[i] % N) + '1';
+    }
+
+    /*!
+     * \brief apply Get the state of the problem when applying a solution to it.
+     */
+    State apply(const Solution& s) const
+    {
+        std::string grid{};
+        apply(s, grid);
+
+        State ret{};
+        for (size_t i{ 0 }; i < N; ++i)
+            ret.emplace_back(grid, i * N, N);
+        return ret;
+    }
+
+private:
+    static constexpr typename Base::Arena ARENA{ Base::build(layout()) };
+
+    LatinSquares() noexcept
+      : Base{ ARENA }
+    {
+        _initGrid.fill('0');
+    }
+
+    std::array<char, N * N> _initGrid;
+};
+
+/*!
+ * \brief The NQueens class is the compile-time version of \a ecv::NQueens, for boards of
+ * \a N * \a N cells. Row ids of solutions match the ones of \a ecv::NQueens.
+ */
+template<size_t N>
+class NQueens : public Links<N * N, 2 * N + 2 * (2 * N - 1), 4, 2 * N, N>
+{
+    using Base = Links<N * N, 2 * N + 2 * (2 * N - 1), 4, 2 * N, N>;
+
+public:
+    using typename Base::Layout;
+    using typename Base::Solution;
+
+    /*!
+     * \brief layout The constraints of every placement (placing a queen in a cell) :
+     * 1 queen per row and per col (primary), at most 1 queen per diagonal (secondary)
+     */
+    static constexpr Layout layout() noexcept
+    {
+        Layout ret{};
+        for (size_t i{ 0 }; i < N; ++i)
+            for (size_t j{ 0 }; j < N; ++j)
+                ret[i * N + j] = { static_cast<typename Base::index_t>(i),
+                                   static_cast<typename Base::index_t>(N + j),
+                                   static_cast<typename Base::index_t>(2 * N + N - 1 + i - j),
+                                   static_cast<typename Base::index_t>(4 * N - 1 + i + j) };
+        return ret;
+    }
+
+    /*!
+     * \brief parse Create the problem from the N * N cells of the board, row after row.
+     * Use '0' to represent empty cells, everything else for a cell with a Queen.
+     * \return The problem in case of success, std::nullopt otherwise
+     */
+    static std::optional<NQueens> parse(std::string_view board) noexcept
+    {
+        if (N * N != std::size(board))
+            return std::nullopt;
+
+        std::optional<NQueens> ret{ NQueens{} };
+        for (size_t p{ 0 }; p < N * N; ++p) {
+            if ('0' == board[p])
+                continue;
+
+            ret->_initBoard[p] = board[p];
+            if (!ret->select(p))
+                return std::nullopt;
+        }
+        return ret;
+    }
+
+    /*!
+     * \brief generate Create the problem from its board representation (\see ecv::NQueens)
+     * \return The problem in case of success, std::nullopt otherwise
+     */
+    static std::optional<NQueens> generate(const State& state) noexcept
+    {
+        std::array<char, N * N> board{};
+        if (N != std::size(state))
+            return std::nullopt;
+        for (size_t i{ 0 }; i < N; ++i) {
+            if (N != std::size(state[i]))
+                return std::nullopt;
+            std::copy(std::begin(state[i]), std::end(state[i]), std::begin(board) + i * N);
+        }
+        return parse(std::string_view{ board.data(), N * N });
+    }
+
+    /*!
+     * \brief apply Get the N * N cells of the board when applying a solution to it.
+     */
+    void apply(const Solution& s, std::string& board) const
+    {
+        board.assign(_initBoard.data(), N * N);
+        for (size_t i{ 0 }; i < s._size; ++i)
+            board[s._d[i]] = '1';
+    }
+
+    /*!
+     * \brief apply Get the state of the problem when applying a solution to it.
+     */
+    State apply(const Solution& s) const
+    {
+        std::string board{};
+        apply(s, board);
+
+        State ret{};
+        for (size_t i{ 0 }; i < N; ++i)
+            ret.emplace_back(board, i * N, N);
+        return ret;
+    }
+
+private:
+    static constexpr typename Base::Arena ARENA{ Base::build(layout()) };
+
+    NQueens() noexcept
+      : Base{ ARENA }
+    {
+        _initBoard.fill('0');
+    }
+
+    std::array<char, N * N> _initBoard;
+};
+
+} // namespace fixed
+} // namespace ecv
+
+#endif // INCLUDE_ECV_FIXED_HPP
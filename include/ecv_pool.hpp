@@ -0,0 +1,188 @@
+/**
+ * @file ecv_pool.hpp
+ * @brief Thread pool solving many exact cover problems concurrently
+ * @author lhm
+ */
+
+#ifndef INCLUDE_ECV_POOL_HPP
+#define INCLUDE_ECV_POOL_HPP
+
+// Project's headers
+#include <ecv.hpp>
+
+// Standard headers
+#include <functional>
+#include <future>
+#include <type_traits>
+
+namespace ecv {
+
+/*!
+ * \brief The SolverPool class solves many (small) problems concurrently, on worker threads that
+ * live as long as the pool.
+ *
+ * Every worker owns a scratch buffer : each job builds and solves its problem from a monotonic
+ * arena over it (spilling over to the heap when it is too small), which is released at once when
+ * the job ends. Only the results of the jobs (and the problem objects) use the heap.
+ */
+class SolverPool
+{
+public:
+    /*!
+     * \brief Task is a job run by a worker. It is given the scratch memory of the job, which is
+     * released as soon as it returns.
+     */
+    using Task = std::function<void(std::pmr::memory_resource* scratch)>;
+
+    struct Metrics
+    {
+        size_t   _threads{ 0 };     ///< Number of workers
+        size_t   _queued{ 0 };      ///< Jobs waiting for a worker
+        size_t   _running{ 0 };     ///< Jobs being run
+        uint64_t _completed{ 0 };   ///< Jobs done since the creation of the pool
+        uint64_t _failed{ 0 };      ///< Completed jobs of \a post that threw an exception
+        double   _meanWait{ 0 };    ///< Mean time (in seconds) spent by the jobs in the queue
+        double   _meanLatency{ 0 }; ///< Mean time (in seconds) from submission to completion
+        double   _maxLatency{ 0 };  ///< Longest time (in seconds) from submission to completion
+    };
+
+public:
+    /*!
+     * \brief SolverPool Start the worker threads
+     * \param threads The number of workers (0 for one per core)
+     * \param scratch The size (in bytes) of the scratch buffer of every worker
+     */
+    explicit SolverPool(size_t threads = 0, size_t scratch = size_t{ 1 } << 20) noexcept;
+
+    /*!
+     * \brief ~SolverPool Run the jobs left in the queue, then stop the workers
+     */
+    ~SolverPool() noexcept;
+
+    SolverPool(const SolverPool&) = delete;
+    SolverPool& operator=(const SolverPool&) = delete;
+
+    /*!
+     * \brief post Queue a job
+     * \param task The job, run by the first available worker. An exception it throws is dropped,
+     * and only counted in the metrics (use \a submit to get it back).
+     */
+    void post(Task task) noexcept;
+
+    /*!
+     * \brief submit Queue a job returning a value
+     * \param f The job, called with its scratch memory. Its result must not use it.
+     * \return The future result of the job (holding its exception if it throws)
+     */
+    template<typename F>
+    auto submit(F&& f) noexcept
+      -> std::future<std::invoke_result_t<std::decay_t<F>&, std::pmr::memory_resource*>>;
+
+    /*!
+     * \brief solve Generate a concrete problem (\a Sudoku, \a LatinSquares or \a NQueens) on a
+     * worker and solve it
+     * \param state The initial state of the problem
+     * \param max_solutions The maximum number of solutions to look for
+     * \return The future states of the solutions (none if \a state is invalid)
+     */
+    template<typename Problem>
+    std::future<std::vector<State>> solve(
+      State    state,
+      uint32_t max_solutions = std::numeric_limits<uint32_t>::max()) noexcept;
+
+    /*!
+     * \brief solve Same as \a solve, giving the states of the solutions to a callback
+     * \param done Called on the worker thread with the states of the solutions
+     */
+    template<typename Problem>
+    void solve(State                                   state,
+               uint32_t                                max_solutions,
+               std::function<void(std::vector<State>)> done) noexcept;
+
+    /*!
+     * \brief solve Generate a generic problem on a worker and solve it
+     * \param m The adjacency matrix, whose arrays must remain valid until the result is ready
+     * \param max_solutions The maximum number of solutions to look for
+     * \return The future row indexes of the solutions (none if \a m is invalid)
+     */
+    std::future<std::vector<std::vector<int>>> solve(
+      const SparseMatrix& m,
+      uint32_t            max_solutions = std::numeric_limits<uint32_t>::max()) noexcept;
+
+    /*!
+     * \brief metrics Get the current load of the pool and the latency of its jobs
+     *
+     * A job is accounted for once it has returned, i.e. just after its result is made available :
+     * the metrics read right after a future is ready may not include its job yet.
+     */
+    Metrics metrics(void) const noexcept;
+
+private:
+    template<typename Problem>
+    static std::vector<State> run(const State&               state,
+                                  uint32_t                   max_solutions,
+                                  std::pmr::memory_resource* scratch) noexcept;
+
+    struct Impl;
+    std::unique_ptr<Impl> pimpl{ nullptr };
+};
+
+/*****************************************************************************/
+template<typename F>
+auto
+SolverPool::submit(F&& f) noexcept
+  -> std::future<std::invoke_result_t<std::decay_t<F>&, std::pmr::memory_resource*>>
+{
+    using R = std::invoke_result_t<std::decay_t<F>&, std::pmr::memory_resource*>;
+
+    // Tasks have to be copyable, unlike packaged tasks
+    auto job{ std::make_shared<std::packaged_task<R(std::pmr::memory_resource*)>>(
+      std::forward<F>(f)) };
+    auto ret{ job->get_future() };
+    post([job](std::pmr::memory_resource* scratch) { (*job)(scratch); });
+    return ret;
+}
+
+/*****************************************************************************/
+template<typename Problem>
+std::vector<State>
+SolverPool::run(const State&               state,
+                uint32_t                   max_solutions,
+                std::pmr::memory_resource* scratch) noexcept
+{
+    std::vector<State> ret{};
+
+    auto problem{ Problem::generate(state, scratch) };
+    if (nullptr != problem)
+        for (const auto& s : problem->solve(max_solutions))
+            ret.push_back(problem->apply(s));
+
+    return ret;
+}
+
+/*****************************************************************************/
+template<typename Problem>
+std::future<std::vector<State>>
+SolverPool::solve(State state, uint32_t max_solutions) noexcept
+{
+    return submit([state = std::move(state), max_solutions](std::pmr::memory_resource* scratch) {
+        return run<Problem>(state, max_solutions, scratch);
+    });
+}
+
+/*****************************************************************************/
+template<typename Problem>
+void
+SolverPool::solve(State                                   state,
+                  uint32_t                                max_solutions,
+                  std::function<void(std::vector<State>)> done) noexcept
+{
+    post([state = std::move(state), max_solutions, done = std::move(done)](
+           std::pmr::memory_resource* scratch) {
+        done(run<Problem>(state, max_solutions, scratch));
+    });
+}
+
+} // namespace ecv
+
+#endif // INCLUDE_ECV_POOL_HPP
@@ -0,0 +1,141 @@
+/**
+ * @file ecv_stream.hpp
+ * @brief Compact binary streams of solutions
+ * @author lhm
+ */
+
+#ifndef INCLUDE_ECV_STREAM_HPP
+#define INCLUDE_ECV_STREAM_HPP
+
+// Project's headers
+#include <ecv.hpp>
+
+namespace ecv {
+
+/*!
+ * \brief The SolutionWriter class writes solutions to a compact binary stream, straight from the
+ * search (\see DLX::enumerate), without building their states.
+ *
+ * Binary layout (native endianness) :
+ *  - char[4]  magic "ECVS"
+ *  - uint32_t version (1)
+ *  - uint32_t block size (in bytes)
+ *  - uint32_t flags (1 when the rows of every solution are sorted)
+ *  - blocks of exactly block size bytes, each holding whole solutions :
+ *     - uint32_t number of solutions in the block
+ *     - uint32_t number of bytes used by them
+ *     - the solutions, zero-padded up to the end of the block
+ *
+ * Every solution is a varint number of rows, followed by the differences between consecutive row
+ * identifiers (the first one from 0), as zigzag varints. Sorting the rows makes the differences
+ * small and positive, mostly one byte each.
+ */
+class SolutionWriter
+{
+public:
+    /*!
+     * \brief SolutionWriter Write the header of the stream
+     * \param out The output stream, opened in binary mode. It must outlive the writer.
+     * \param problem The problem whose solutions are written. It must outlive the writer.
+     * \param sorted Sort the rows of every solution (their order is lost)
+     * \param blockSize The size (in bytes) of the blocks (at least 64). When it cannot hold the
+     * largest solution of \a problem, nothing is written and the writer is failed at once.
+     */
+    SolutionWriter(std::ostream& out,
+                   DLX&          problem,
+                   bool          sorted = true,
+                   uint32_t      blockSize = uint32_t{ 1 } << 16) noexcept;
+
+    /*!
+     * \brief ~SolutionWriter Write the last block
+     */
+    ~SolutionWriter() noexcept;
+
+    SolutionWriter(const SolutionWriter&) = delete;
+    SolutionWriter& operator=(const SolutionWriter&) = delete;
+
+    /*!
+     * \brief write Append a solution to the current block, writing the block first if it is full
+     * \param rows The row identifiers of the solution
+     * \return false if the stream failed, or the solution does not fit in a block (the writer is
+     * then failed, and writes nothing more)
+     */
+    bool write(const std::pmr::vector<int>& rows) noexcept;
+
+    /*!
+     * \brief visitor Get a visitor writing every solution it is given, for \a DLX::enumerate of
+     * the problem. It stops the search as soon as a solution cannot be written.
+     */
+    DLX::Visitor visitor(void) noexcept;
+
+    /*!
+     * \brief failed Has a solution been lost, or the block size been rejected. The number of
+     * solutions returned by \a DLX::enumerate may then exceed \a count.
+     */
+    bool failed(void) const noexcept;
+
+    /*!
+     * \brief flush Write the current block (even if it is not full) and flush the stream
+     * \return false if the stream failed, or the writer is failed (\see failed)
+     */
+    bool flush(void) noexcept;
+
+    /*!
+     * \brief count Get the number of solutions written so far
+     */
+    uint64_t count(void) const noexcept;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pimpl{ nullptr };
+};
+
+/*!
+ * \brief The SolutionReader class reads back the solutions written by a \a SolutionWriter
+ */
+class SolutionReader
+{
+public:
+    /*!
+     * \brief SolutionReader Read the header of the stream
+     * \param in The input stream, opened in binary mode. It must outlive the reader.
+     */
+    explicit SolutionReader(std::istream& in) noexcept;
+    ~SolutionReader() noexcept;
+
+    SolutionReader(const SolutionReader&) = delete;
+    SolutionReader& operator=(const SolutionReader&) = delete;
+
+    /*!
+     * \brief valid Is the stream well-formed so far
+     */
+    bool valid(void) const noexcept;
+
+    /*!
+     * \brief sorted Were the rows of the solutions sorted by the writer
+     */
+    bool sorted(void) const noexcept;
+
+    /*!
+     * \brief next Read the next solution
+     * \param rows Filled with the row identifiers of the solution
+     * \return false at the end of the stream, or if it is malformed (\see valid)
+     */
+    bool next(std::vector<int>& rows) noexcept;
+
+    /*!
+     * \brief next Read the next solution, and rebuild its state
+     * \param problem The problem the solutions were written from (\see ConcreteProblem::apply)
+     * \param state Filled with the state of the problem when applying the solution
+     * \return false at the end of the stream, or if it is malformed (\see valid)
+     */
+    bool next(ConcreteProblem& problem, State& state) noexcept;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pimpl{ nullptr };
+};
+
+} // namespace ecv
+
+#endif // INCLUDE_ECV_STREAM_HPP
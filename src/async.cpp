@@ -0,0 +1,174 @@
+/**
+ * @file async.cpp
+ * @brief Implementation of the asynchronous search part of \a ecv.hpp
+ * @author lhm
+ */
+
+// Project's headers
+#include "links.hpp"
+
+// Standard headers
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace ecv {
+
+struct DLX::AsyncSolve::Impl
+{
+    std::shared_ptr<DLX::Impl> _links; // Kept alive until the end of the search
+    detail::Control            _control{};
+    std::atomic<uint64_t>      _solutions{ 0 };
+    std::thread                _thread{};
+
+    mutable std::mutex              _mtx{};
+    mutable std::condition_variable _cv{};
+    bool                            _done{ false }; // Under _mtx
+    std::vector<std::vector<int>>   _pending{};     // Under _mtx, solutions not polled yet
+
+    explicit Impl(std::shared_ptr<DLX::Impl> links) noexcept
+      : _links{ std::move(links) }
+    {}
+
+    void run(const SolveOptions& options) noexcept;
+};
+
+/*****************************************************************************/
+void
+DLX::AsyncSolve::Impl::run(const SolveOptions& options) noexcept
+{
+    Visitor keep{ [this](const std::pmr::vector<int>& rows) {
+        {
+            std::lock_guard lock{ _mtx };
+            _pending.emplace_back(std::begin(rows), std::end(rows));
+        }
+        _solutions.fetch_add(1, std::memory_order_relaxed);
+    } };
+    Visitor count{ [this](const std::pmr::vector<int>&) {
+        _solutions.fetch_add(1, std::memory_order_relaxed);
+    } };
+
+    _links->_control = &_control;
+    _links->enumerate(options._keep ? keep : count, options._maxSolutions);
+    _links->_control = nullptr;
+    _control._nodes.store(_control._count, std::memory_order_relaxed);
+    _links->_busy.store(false, std::memory_order_release); // Taken by solve_async
+
+    {
+        std::lock_guard lock{ _mtx };
+        _done = true;
+    }
+    _cv.notify_all();
+}
+
+/*****************************************************************************/
+DLX::AsyncSolve::AsyncSolve() noexcept = default;
+DLX::AsyncSolve::AsyncSolve(AsyncSolve&&) noexcept = default;
+
+/*****************************************************************************/
+DLX::AsyncSolve&
+DLX::AsyncSolve::operator=(AsyncSolve&& other) noexcept
+{
+    if (this != &other) {
+        cancel();
+        if (nullptr != pimpl && pimpl->_thread.joinable())
+            pimpl->_thread.join();
+        pimpl = std::move(other.pimpl);
+    }
+    return *this;
+}
+
+/*****************************************************************************/
+DLX::AsyncSolve::~AsyncSolve() noexcept
+{
+    // The search checks for cancellation every 1024 nodes : it stops almost at once
+    cancel();
+    if (nullptr != pimpl && pimpl->_thread.joinable())
+        pimpl->_thread.join();
+}
+
+/*****************************************************************************/
+void
+DLX::AsyncSolve::wait(void) const noexcept
+{
+    if (nullptr == pimpl)
+        return; // Moved from
+
+    std::unique_lock lock{ pimpl->_mtx };
+    pimpl->_cv.wait(lock, [this]() { return pimpl->_done; });
+}
+
+/*****************************************************************************/
+bool
+DLX::AsyncSolve::wait_for(std::chrono::nanoseconds timeout) const noexcept
+{
+    if (nullptr == pimpl)
+        return true;
+
+    std::unique_lock lock{ pimpl->_mtx };
+    return pimpl->_cv.wait_for(lock, timeout, [this]() { return pimpl->_done; });
+}
+
+/*****************************************************************************/
+bool
+DLX::AsyncSolve::done(void) const noexcept
+{
+    if (nullptr == pimpl)
+        return true;
+
+    std::lock_guard lock{ pimpl->_mtx };
+    return pimpl->_done;
+}
+
+/*****************************************************************************/
+DLX::AsyncSolve::Progress
+DLX::AsyncSolve::progress(void) const noexcept
+{
+    Progress ret{};
+    ret._done = done(); // First, so that the counters are final when it is set
+    if (nullptr == pimpl)
+        return ret;
+
+    ret._nodes = pimpl->_control._nodes.load(std::memory_order_relaxed);
+    ret._solutions = pimpl->_solutions.load(std::memory_order_relaxed);
+    return ret;
+}
+
+/*****************************************************************************/
+std::vector<std::vector<int>>
+DLX::AsyncSolve::poll(void) noexcept
+{
+    std::vector<std::vector<int>> ret{};
+    if (nullptr == pimpl)
+        return ret;
+
+    std::lock_guard lock{ pimpl->_mtx };
+    std::swap(ret, pimpl->_pending);
+    return ret;
+}
+
+/*****************************************************************************/
+void
+DLX::AsyncSolve::cancel(void) noexcept
+{
+    if (nullptr != pimpl)
+        pimpl->_control._cancel.store(true, std::memory_order_relaxed);
+}
+
+/*****************************************************************************/
+DLX::AsyncSolve
+DLX::solve_async(const SolveOptions& options) noexcept
+{
+    AsyncSolve ret{};
+    ret.pimpl = std::make_unique<AsyncSolve::Impl>(pimpl);
+    if (pimpl->_busy.exchange(true, std::memory_order_acquire)) {
+        ret.pimpl->_done = true; // Another search runs on the nodes : refused
+        return ret;
+    }
+
+    auto impl{ ret.pimpl.get() };
+    impl->_thread = std::thread{ [impl, options]() { impl->run(options); } };
+    return ret;
+}
+
+} // namespace ecv
@@ -0,0 +1,430 @@
+/**
+ * @file cache.cpp
+ * @brief Implementation of \a ecv_cache.hpp
+ * @author lhm
+ */
+
+// Project's headers
+#include <ecv_cache.hpp>
+
+// Standard headers
+#include <algorithm>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace ecv {
+
+namespace {
+constexpr uint64_t BUDGET{ uint64_t{ 1 } << 18 }; // Cells visited by a canonicalization
+constexpr uint8_t  NONE{ 0xFF };                  // Row or column not chosen yet
+
+/*****************************************************************************/
+template<typename Problem>
+struct Traits;
+
+template<>
+struct Traits<Sudoku>
+{
+    // Rows (and columns) are permuted within bands of 3, and bands between them
+    static constexpr size_t block(size_t N) noexcept { return (9 == N) ? 3 : 0; }
+};
+
+template<>
+struct Traits<LatinSquares>
+{
+    // Rows (and columns) are permuted freely
+    static constexpr size_t block(size_t N) noexcept { return (0 < N) ? 1 : 0; }
+};
+
+/*****************************************************************************/
+class Canonizer
+{
+public:
+    Canonizer(std::string_view grid, size_t N, size_t B) noexcept;
+
+    /*!
+     * \brief run Find the canonical form of the grid
+     * \return false if the grid is invalid, or the search budget was exhausted
+     */
+    bool run(void) noexcept;
+
+    std::string canonical(void) const noexcept;
+    std::string restore(std::string_view solution) const noexcept;
+
+private:
+    void search(size_t pos) noexcept;
+    void choose(std::vector<uint8_t>&     map,
+                std::vector<char>&        used,
+                std::vector<char>&        bands,
+                const std::vector<size_t> counts[2],
+                size_t                    p,
+                size_t                    pos) noexcept;
+
+    const size_t         _N, _B;
+    std::vector<uint8_t> _cells{};
+    bool                 _valid{ false };
+
+    // Givens of every row (then band), and of every column (then stack). Those counts do not
+    // depend on the transformation : rows and columns are taken in increasing order of them,
+    // which leaves far less transformations to compare, without breaking canonicity.
+    std::vector<size_t>  _rowCounts[2]{}, _colCounts[2]{};
+
+    // Current transformation : transposition, then the source of every row and column, and the
+    // label of every digit
+    bool                 _t{ false };
+    std::vector<uint8_t> _rows{}, _cols{}, _labels{}, _cur{};
+    std::vector<char>    _usedRows{}, _usedCols{}, _rowBands{}, _colBands{};
+    uint8_t              _next{ 0 };     // Last label given
+    bool                 _less{ false }; // Is the current grid already smaller than the best one
+    uint64_t             _version{ 0 };  // Number of best grids found
+    uint64_t             _nodes{ 0 };
+    bool                 _aborted{ false };
+
+    // Smallest grid, and its transformation
+    bool                 _bestT{ false };
+    std::vector<uint8_t> _best{}, _bestRows{}, _bestCols{}, _bestLabels{};
+};
+
+/*****************************************************************************/
+Canonizer::Canonizer(std::string_view grid, size_t N, size_t B) noexcept
+  : _N{ N }
+  , _B{ B }
+{
+    if (0 == B || 0 != N % B || N * N != std::size(grid) || NONE <= N)
+        return;
+
+    _cells.reserve(N * N);
+    for (auto c : grid) {
+        auto val{ ('.' == c) ? 0 : c - '0' };
+        if (0 > val || static_cast<int>(N) < val)
+            return;
+        _cells.push_back(val);
+    }
+
+    for (auto counts : { _rowCounts, _colCounts })
+        for (size_t k{ 0 }; k < 2; ++k)
+            counts[k].assign(0 == k ? N : N / B, 0);
+    for (size_t i{ 0 }; i < N * N; ++i) {
+        if (0 == _cells[i])
+            continue;
+        ++_rowCounts[0][i / N];
+        ++_rowCounts[1][i / N / B];
+        ++_colCounts[0][i % N];
+        ++_colCounts[1][i % N / B];
+    }
+
+    _rows.assign(N, NONE);
+    _cols.assign(N, NONE);
+    _labels.assign(N + 1, 0);
+    _cur.assign(N * N, 0);
+    _usedRows.assign(N, false);
+    _usedCols.assign(N, false);
+    _rowBands.assign(N / B, false);
+    _colBands.assign(N / B, false);
+    _best.assign(N * N, NONE); // Greater than any grid
+    _valid = true;
+}
+
+/*****************************************************************************/
+bool
+Canonizer::run(void) noexcept
+{
+    if (!_valid)
+        return false;
+
+    for (auto t : { false, true }) {
+        _t = t;
+        search(0);
+        if (_aborted)
+            return false;
+    }
+
+    // Digits missing from the grid get the last labels
+    auto next{ *std::max_element(std::begin(_bestLabels), std::end(_bestLabels)) };
+    for (size_t d{ 1 }; d <= _N; ++d)
+        if (0 == _bestLabels[d])
+            _bestLabels[d] = ++next;
+    return true;
+}
+
+/*****************************************************************************/
+void
+Canonizer::choose(std::vector<uint8_t>&     map,
+                  std::vector<char>&        used,
+                  std::vector<char>&        bands,
+                  const std::vector<size_t> counts[2],
+                  size_t                    p,
+                  size_t                    pos) noexcept
+{
+    // The first row of a band comes from any band left, the other ones from the same band
+    auto   first{ 0 == p % _B };
+    size_t from{ 0 }, to{ _N };
+    if (!first) {
+        from = map[p - p % _B] / _B * _B;
+        to = from + _B;
+    }
+
+    // Only the rows of the least given band, then the least given rows, are candidates
+    auto key{ [&](size_t s) {
+        return first ? counts[1][s / _B] * (_N + 1) + counts[0][s] : counts[0][s];
+    } };
+    auto least{ std::numeric_limits<size_t>::max() };
+    for (auto s{ from }; s < to; ++s)
+        if (!used[s] && !(first && bands[s / _B]))
+            least = std::min(least, key(s));
+
+    for (auto s{ from }; s < to && !_aborted; ++s) {
+        if (used[s] || (first && bands[s / _B]) || least != key(s))
+            continue;
+
+        used[s] = true;
+        if (first)
+            bands[s / _B] = true;
+        map[p] = s;
+
+        search(pos);
+
+        used[s] = false;
+        if (first)
+            bands[s / _B] = false;
+    }
+    map[p] = NONE;
+}
+
+/*****************************************************************************/
+void
+Canonizer::search(size_t pos) noexcept
+{
+    if (_N * _N == pos) {
+        if (_less) {
+            _bestT = _t;
+            _best = _cur;
+            _bestRows = _rows;
+            _bestCols = _cols;
+            _bestLabels = _labels;
+            ++_version;
+        }
+        return;
+    }
+
+    // The rows and columns are chosen as late as possible, so that the smallest cells come first
+    auto r{ pos / _N }, c{ pos % _N };
+    if (NONE == _rows[r])
+        return choose(_rows, _usedRows, _rowBands, _t ? _colCounts : _rowCounts, r, pos);
+    if (NONE == _cols[c])
+        return choose(_cols, _usedCols, _colBands, _t ? _rowCounts : _colCounts, c, pos);
+
+    if (BUDGET < ++_nodes) {
+        _aborted = true;
+        return;
+    }
+
+    // Digits are labeled in the order they appear in : the smallest relabeling of the grid
+    auto    d{ _t ? _cells[_cols[c] * _N + _rows[r]] : _cells[_rows[r] * _N + _cols[c]] };
+    uint8_t v{ 0 };
+    auto    fresh{ false };
+    if (0 != d) {
+        fresh = (0 == _labels[d]);
+        if (fresh)
+            _labels[d] = ++_next;
+        v = _labels[d];
+    }
+
+    auto less{ _less };
+    if (_less || v <= _best[pos]) {
+        _cur[pos] = v;
+        _less = _less || v < _best[pos];
+
+        auto version{ _version };
+        search(pos + 1);
+        // Once a best grid is found below, the current one is its prefix
+        _less = (version == _version) && less;
+    }
+
+    if (fresh) {
+        _labels[d] = 0;
+        --_next;
+    }
+}
+
+/*****************************************************************************/
+std::string
+Canonizer::canonical(void) const noexcept
+{
+    std::string ret(_N * _N, '0');
+    for (size_t i{ 0 }; i < _N * _N; ++i)
+        ret[i] = '0' + _best[i];
+    return ret;
+}
+
+/*****************************************************************************/
+std::string
+Canonizer::restore(std::string_view solution) const noexcept
+{
+    std::vector<uint8_t> digits(_N + 1, 0);
+    for (size_t d{ 1 }; d <= _N; ++d)
+        digits[_bestLabels[d]] = d;
+
+    std::string ret(_N * _N, '0');
+    for (size_t r{ 0 }; r < _N; ++r) {
+        for (size_t c{ 0 }; c < _N; ++c) {
+            size_t s{ _bestRows[r] }, t{ _bestCols[c] };
+            ret[_bestT ? t * _N + s : s * _N + t] = '0' + digits[solution[r * _N + c] - '0'];
+        }
+    }
+    return ret;
+}
+} // namespace
+
+template<typename Problem>
+struct ResultCache<Problem>::Impl
+{
+    using Entry = std::pair<std::string, std::vector<std::string>>; // Canonical form, solutions
+
+    const size_t       _capacity;
+    const uint32_t     _max;
+    std::list<Entry>   _lru{}; // Most recently used first
+    mutable std::mutex _mtx{};
+    Stats              _stats{};
+    std::unordered_map<std::string_view, typename std::list<Entry>::iterator> _index{};
+
+    Impl(size_t capacity, uint32_t max_solutions) noexcept
+      : _capacity{ std::max(capacity, size_t{ 1 }) }
+      , _max{ max_solutions }
+    {}
+
+    std::vector<std::string> direct(std::string_view grid) const noexcept;
+};
+
+/*****************************************************************************/
+template<typename Problem>
+std::vector<std::string>
+ResultCache<Problem>::Impl::direct(std::string_view grid) const noexcept
+{
+    std::vector<std::string> ret{};
+
+    auto problem{ Problem::parse(grid) };
+    if (nullptr != problem) {
+        for (const auto& s : problem->solve(_max)) {
+            ret.emplace_back();
+            problem->apply(s, ret.back());
+        }
+    }
+    return ret;
+}
+
+/*****************************************************************************/
+template<typename Problem>
+ResultCache<Problem>::ResultCache(size_t capacity, uint32_t max_solutions) noexcept
+  : pimpl{ std::make_unique<Impl>(capacity, max_solutions) }
+{}
+
+/*****************************************************************************/
+template<typename Problem>
+ResultCache<Problem>::~ResultCache() noexcept = default;
+
+/*****************************************************************************/
+template<typename Problem>
+std::vector<std::string>
+ResultCache<Problem>::solve(std::string_view grid) noexcept
+{
+    auto& impl{ *pimpl };
+
+    size_t N{ 0 };
+    while ((N + 1) * (N + 1) <= std::size(grid))
+        ++N;
+
+    Canonizer canon{ grid, N, Traits<Problem>::block(N) };
+    if (!canon.run()) {
+        {
+            std::lock_guard lock{ impl._mtx };
+            ++impl._stats._bypassed;
+        }
+        return impl.direct(grid);
+    }
+
+    auto                     key{ canon.canonical() };
+    std::vector<std::string> ret{};
+    auto                     hit{ false };
+    {
+        std::lock_guard lock{ impl._mtx };
+        if (auto it{ impl._index.find(key) }; std::end(impl._index) != it) {
+            impl._lru.splice(std::begin(impl._lru), impl._lru, it->second);
+            ret = it->second->second;
+            hit = true;
+            ++impl._stats._hits;
+        }
+    }
+
+    if (!hit) {
+        // Solved without holding the lock : another thread may cache the same form meanwhile
+        ret = impl.direct(key);
+
+        std::lock_guard lock{ impl._mtx };
+        ++impl._stats._misses;
+        if (std::end(impl._index) == impl._index.find(key)) {
+            impl._lru.emplace_front(std::move(key), ret);
+            impl._index.emplace(impl._lru.front().first, std::begin(impl._lru));
+            if (impl._capacity < std::size(impl._lru)) {
+                impl._index.erase(impl._lru.back().first);
+                impl._lru.pop_back();
+            }
+        }
+    }
+
+    for (auto& s : ret)
+        s = canon.restore(s);
+    return ret;
+}
+
+/*****************************************************************************/
+template<typename Problem>
+std::vector<State>
+ResultCache<Problem>::solve(const State& state) noexcept
+{
+    auto N{ std::size(state) };
+
+    std::string grid{};
+    grid.reserve(N * N);
+    for (const auto& line : state) {
+        if (N != std::size(line))
+            return {};
+        grid += line;
+    }
+
+    std::vector<State> ret{};
+    for (const auto& s : solve(grid)) {
+        auto& st{ ret.emplace_back() };
+        for (size_t i{ 0 }; i < N; ++i)
+            st.emplace_back(s, i * N, N);
+    }
+    return ret;
+}
+
+/*****************************************************************************/
+template<typename Problem>
+typename ResultCache<Problem>::Stats
+ResultCache<Problem>::stats(void) const noexcept
+{
+    std::lock_guard lock{ pimpl->_mtx };
+
+    auto ret{ pimpl->_stats };
+    ret._size = std::size(pimpl->_lru);
+    return ret;
+}
+
+/*****************************************************************************/
+template<typename Problem>
+void
+ResultCache<Problem>::clear(void) noexcept
+{
+    std::lock_guard lock{ pimpl->_mtx };
+    pimpl->_index.clear();
+    pimpl->_lru.clear();
+}
+
+template class ResultCache<Sudoku>;
+template class ResultCache<LatinSquares>;
+
+} // namespace ecv
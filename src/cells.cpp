@@ -0,0 +1,168 @@
+/**
+ * @file cells.cpp
+ * @brief Implementation of \a cells.hpp
+ * @author lhm
+ */
+
+// Project's headers
+#include "cells.hpp"
+#include "links.hpp"
+
+namespace ecv {
+namespace detail {
+
+/*****************************************************************************/
+Cells::Cells(const Matrix& m, std::pmr::memory_resource* resource) noexcept
+  : _offsets(std::begin(m._offsets), std::end(m._offsets), resource)
+  , _item(std::begin(m._indices), std::end(m._indices), resource)
+  , _option(std::size(m._indices), resource)
+  , _loc(std::size(m._indices), resource)
+  , _rowIds(m._rowIds, resource)
+  , _start(m._cols + 1, 0, resource)
+  , _size(m._cols, 0, resource)
+  , _set(std::size(m._indices), resource)
+  , _covered(m._cols, false, resource)
+  , _active(m._primary, resource)
+  , _activePos(m._cols, 0, resource)
+  , _nbActive(m._primary)
+  , _curSol(resource)
+{
+    _curSol.reserve(m._rows);
+
+    for (size_t o{ 0 }; o < m._rows; ++o)
+        for (auto k{ _offsets[o] }; k < _offsets[o + 1]; ++k)
+            _option[k] = o;
+
+    // Group the nodes by item, in option order
+    for (auto item : _item)
+        ++_start[item + 1];
+    for (size_t i{ 0 }; i < m._cols; ++i)
+        _start[i + 1] += _start[i];
+
+    for (uint32_t k{ 0 }; k < std::size(_item); ++k) {
+        auto item{ _item[k] };
+        _loc[k] = _start[item] + _size[item]++;
+        _set[_loc[k]] = k;
+    }
+
+    for (uint32_t i{ 0 }; i < m._primary; ++i)
+        _active[i] = _activePos[i] = i;
+}
+
+/*****************************************************************************/
+void
+Cells::hide(uint32_t node) noexcept
+{
+    // Remove the option of node from the sets of its other (active) items
+    auto o{ _option[node] };
+    for (auto k{ _offsets[o] }; k < _offsets[o + 1]; ++k) {
+        auto item{ _item[k] };
+        if (k == node || _covered[item])
+            continue;
+
+        auto last{ _start[item] + --_size[item] }, pos{ _loc[k] };
+        auto other{ _set[last] };
+        _set[last] = k;
+        _set[pos] = other;
+        _loc[k] = last;
+        _loc[other] = pos;
+    }
+}
+
+/*****************************************************************************/
+void
+Cells::unhide(uint32_t node) noexcept
+{
+    // Removed nodes were swapped just past the end of the sets : growing them back is enough
+    auto o{ _option[node] };
+    for (auto k{ _offsets[o + 1] }; k-- > _offsets[o];)
+        if (k != node && !_covered[_item[k]])
+            ++_size[_item[k]];
+}
+
+/*****************************************************************************/
+void
+Cells::cover(uint32_t item) noexcept
+{
+    if (item < std::size(_active)) { // Primary item
+        auto last{ --_nbActive }, pos{ _activePos[item] };
+        auto other{ _active[last] };
+        _active[last] = item;
+        _active[pos] = other;
+        _activePos[item] = last;
+        _activePos[other] = pos;
+    }
+
+    _covered[item] = true;
+    for (auto p{ _start[item] }; p < _start[item] + _size[item]; ++p)
+        hide(_set[p]);
+}
+
+/*****************************************************************************/
+void
+Cells::uncover(uint32_t item) noexcept
+{
+    for (auto p{ _start[item] + _size[item] }; p-- > _start[item];)
+        unhide(_set[p]);
+    _covered[item] = false;
+
+    if (item < std::size(_active))
+        ++_nbActive;
+}
+
+/*****************************************************************************/
+uint64_t
+Cells::solve(uint64_t max_solutions, const Callback& f, Control* control) noexcept
+{
+    uint64_t count{ 0 };
+    _control = control;
+    if (0 != max_solutions && !std::empty(_item))
+        _solve(max_solutions, count, f);
+    _control = nullptr;
+    return count;
+}
+
+/*****************************************************************************/
+void
+Cells::_solve(uint64_t max_solutions, uint64_t& count, const Callback& f) noexcept
+{
+    if (nullptr != _control && !_control->visit())
+        return; // Stopped
+
+    if (0 == _nbActive) { // success
+        if (f)
+            f(_curSol);
+        ++count;
+        return;
+    }
+
+    // Select the active primary item having the fewest options
+    auto item{ _active[0] };
+    for (uint32_t i{ 1 }; i < _nbActive && 0 != _size[item]; ++i)
+        if (_size[_active[i]] < _size[item])
+            item = _active[i];
+
+    if (0 == _size[item]) // failure
+        return;
+
+    cover(item);
+    for (auto p{ _start[item] }; p < _start[item] + _size[item] && count < max_solutions; ++p) {
+        auto node{ _set[p] }, o{ _option[node] };
+
+        _curSol.push_back(_rowIds[o]);
+        for (auto k{ _offsets[o] }; k < _offsets[o + 1]; ++k)
+            if (k != node)
+                cover(_item[k]);
+
+        _solve(max_solutions, count, f);
+
+        for (auto k{ _offsets[o + 1] }; k-- > _offsets[o];)
+            if (k != node)
+                uncover(_item[k]);
+        _curSol.pop_back();
+    }
+    uncover(item);
+}
+
+} // namespace detail
+} // namespace ecv
@@ -0,0 +1,77 @@
+/**
+ * @file cells.hpp
+ * @brief "Dancing cells" engine of the ecv library
+ * @author lhm
+ */
+
+#ifndef SRC_CELLS_HPP
+#define SRC_CELLS_HPP
+
+// Project's headers
+#include "matrix.hpp"
+
+// Standard headers
+#include <functional>
+
+namespace ecv {
+namespace detail {
+
+struct Control;
+
+/*!
+ * \brief The Cells class solves exact cover problems using Knuth's sparse-set representation
+ * ("dancing cells") instead of linked lists.
+ *
+ * The active primary items and the options of every item are kept in dense arrays. Removing an
+ * element swaps it with the last active one, and restoring it (in reverse order) only
+ * increments a size counter, so that the search never chases pointers across memory.
+ */
+class Cells
+{
+public:
+    using Callback = std::function<void(const std::pmr::vector<int>&)>;
+
+    Cells(const Matrix& m, std::pmr::memory_resource* resource) noexcept;
+
+    /*!
+     * \brief solve Enumerate the solutions to the problem
+     * \param max_solutions The maximum number of solutions to look for
+     * \param f Called with the row identifiers of every solution (can be empty to only count)
+     * \param control Checked at every node, to stop the search (can be null)
+     * \return The number of solutions found
+     */
+    uint64_t solve(uint64_t max_solutions, const Callback& f, Control* control = nullptr) noexcept;
+
+private:
+    void cover(uint32_t item) noexcept;
+    void uncover(uint32_t item) noexcept;
+    void hide(uint32_t node) noexcept;
+    void unhide(uint32_t node) noexcept;
+    void _solve(uint64_t max_solutions, uint64_t& count, const Callback& f) noexcept;
+
+    // Options (rows), in CSR form : nodes [_offsets[o], _offsets[o + 1]) belong to option o
+    std::pmr::vector<uint32_t> _offsets;
+    std::pmr::vector<uint32_t> _item;   // Item of every node
+    std::pmr::vector<uint32_t> _option; // Option of every node
+    std::pmr::vector<uint32_t> _loc;    // Position of every node in the set of its item
+    std::pmr::vector<int>      _rowIds;
+
+    // Items (columns) : the active options of item i are _set[_start[i], _start[i] + _size[i])
+    std::pmr::vector<uint32_t> _start;
+    std::pmr::vector<uint32_t> _size;
+    std::pmr::vector<uint32_t> _set;
+    std::pmr::vector<char>     _covered;
+
+    // Active primary items are _active[0, _nbActive)
+    std::pmr::vector<uint32_t> _active;
+    std::pmr::vector<uint32_t> _activePos;
+    uint32_t                   _nbActive{ 0 };
+
+    std::pmr::vector<int> _curSol;
+    Control*              _control{ nullptr }; // Of the current search
+};
+
+} // namespace detail
+} // namespace ecv
+
+#endif // SRC_CELLS_HPP
@@ -0,0 +1,207 @@
+/**
+ * @file coverfile.cpp
+ * @brief Implementation of the generic problems files part of \a ecv.hpp
+ * @author lhm
+ */
+
+// Project's headers
+#include <ecv.hpp>
+
+// Standard headers
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <sstream>
+#include <unordered_map>
+
+// System headers
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ecv {
+
+namespace {
+constexpr char     MAGIC[4]{ 'E', 'C', 'V', 'X' };
+constexpr uint32_t VERSION{ 1 };
+
+/*****************************************************************************/
+struct Header
+{
+    char     _magic[4];
+    uint32_t _version;
+    uint64_t _rows;
+    uint64_t _cols;
+    int64_t  _primary;
+    uint64_t _nnz;
+};
+static_assert(40 == sizeof(Header), "Unexpected binary cover header size");
+
+/*****************************************************************************/
+struct MappedFile
+{ ///< Read-only memory mapping of a whole file
+    explicit MappedFile(const std::string& path) noexcept
+    {
+        if (auto fd{ ::open(path.c_str(), O_RDONLY) }; -1 != fd) {
+            struct stat st;
+            if (0 == ::fstat(fd, &st) && 0 < st.st_size) {
+                auto addr{ ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0) };
+                if (MAP_FAILED != addr) {
+                    ::madvise(addr, st.st_size, MADV_SEQUENTIAL);
+                    _data = static_cast<const char*>(addr);
+                    _size = st.st_size;
+                }
+            }
+            ::close(fd);
+        }
+    }
+    ~MappedFile() noexcept
+    {
+        if (nullptr != _data)
+            ::munmap(const_cast<char*>(_data), _size);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* _data{ nullptr };
+    size_t      _size{ 0 };
+};
+
+/*****************************************************************************/
+bool
+isComment(const std::string& line) noexcept
+{
+    auto pos{ line.find_first_not_of(" \t\r") };
+    return std::string::npos == pos || '|' == line[pos];
+}
+
+} // anonymous
+
+/*****************************************************************************/
+std::unique_ptr<GenericProblem>
+GenericProblem::load(const std::string& path, std::pmr::memory_resource* resource) noexcept
+{
+    MappedFile file{ path };
+    if (nullptr == file._data || sizeof(Header) > file._size)
+        return nullptr;
+
+    Header h;
+    std::memcpy(&h, file._data, sizeof(Header));
+    if (0 != std::memcmp(h._magic, MAGIC, sizeof(MAGIC)) || VERSION != h._version)
+        return nullptr;
+
+    // Check the announced sizes against the actual file size before trusting them
+    auto maxRows{ (file._size - sizeof(Header)) / sizeof(uint64_t) };
+    if (h._rows >= maxRows || h._cols > std::numeric_limits<uint32_t>::max() ||
+        h._primary < -1 || h._primary > std::numeric_limits<int>::max() ||
+        h._primary > static_cast<int64_t>(h._cols) ||
+        h._nnz > (file._size - sizeof(Header)) / sizeof(uint32_t))
+        return nullptr;
+
+    auto offsetsSize{ (h._rows + 1) * sizeof(uint64_t) };
+    if (sizeof(Header) + offsetsSize + h._nnz * sizeof(uint32_t) != file._size)
+        return nullptr;
+
+    auto offsets{ reinterpret_cast<const uint64_t*>(file._data + sizeof(Header)) };
+    if (h._nnz != offsets[h._rows])
+        return nullptr;
+
+    return generate(
+      SparseMatrix{ h._rows,
+                    h._cols,
+                    static_cast<int>(h._primary),
+                    offsets,
+                    reinterpret_cast<const uint32_t*>(file._data + sizeof(Header) + offsetsSize) },
+      resource);
+}
+
+/*****************************************************************************/
+bool
+GenericProblem::save(const std::string& path, const SparseMatrix& m) noexcept
+{
+    if (0 == m._rows || 0 == m._cols || nullptr == m._offsets)
+        return false;
+
+    Header h{};
+    std::memcpy(h._magic, MAGIC, sizeof(MAGIC));
+    h._version = VERSION;
+    h._rows = m._rows;
+    h._cols = m._cols;
+    h._primary = (0 > m._primary) ? -1 : m._primary;
+    h._nnz = m._offsets[m._rows];
+
+    std::ofstream out{ path, std::ios::binary | std::ios::trunc };
+    out.write(reinterpret_cast<const char*>(&h), sizeof(Header));
+    out.write(reinterpret_cast<const char*>(m._offsets), (m._rows + 1) * sizeof(uint64_t));
+    out.write(reinterpret_cast<const char*>(m._indices), h._nnz * sizeof(uint32_t));
+
+    return static_cast<bool>(out.flush());
+}
+
+/*****************************************************************************/
+std::unique_ptr<GenericProblem>
+GenericProblem::parse(std::istream& in, std::pmr::memory_resource* resource) noexcept
+{
+    std::string line{};
+    while (std::getline(in, line) && isComment(line))
+        ;
+    if (!in)
+        return nullptr;
+
+    // Items line : primary items, then optionally '|' followed by secondary items
+    std::unordered_map<std::string, uint32_t> items{};
+    int                                       primary{ -1 };
+    {
+        std::istringstream iss{ line };
+        for (std::string name{}; iss >> name;) {
+            if ("|" == name) {
+                if (-1 != primary)
+                    return nullptr;
+                primary = std::size(items);
+                continue;
+            }
+            if (std::string::npos != name.find_first_of(":|") ||
+                !items.emplace(name, std::size(items)).second)
+                return nullptr; // Colors are not supported, and names must be unique
+        }
+    }
+    if (std::empty(items))
+        return nullptr;
+
+    // Options, one per line
+    std::pmr::vector<uint64_t> offsets(1, 0, resource);
+    std::pmr::vector<uint32_t> indices{ resource };
+    while (std::getline(in, line)) {
+        if (isComment(line))
+            continue;
+
+        auto first{ std::size(indices) };
+        for (size_t pos{ 0 }, end{ 0 }; std::string::npos != pos; pos = end) {
+            pos = line.find_first_not_of(" \t\r", pos);
+            if (std::string::npos == pos)
+                break;
+            end = line.find_first_of(" \t\r", pos);
+
+            auto it{ items.find(line.substr(pos, end - pos)) };
+            if (std::end(items) == it)
+                return nullptr;
+            indices.push_back(it->second);
+        }
+
+        auto row{ std::begin(indices) + first };
+        std::sort(row, std::end(indices));
+        if (std::end(indices) != std::adjacent_find(row, std::end(indices)))
+            return nullptr; // An item appears twice in the option
+        offsets.push_back(std::size(indices));
+    }
+
+    return generate(
+      SparseMatrix{
+        std::size(offsets) - 1, std::size(items), primary, offsets.data(), indices.data() },
+      resource);
+}
+
+} // namespace ecv
@@ -5,49 +5,16 @@
  */
 
 // Project's headers
-#include <ecv.hpp>
+#include "links.hpp"
 
-namespace ecv {
-
-namespace {
-struct Column;
-
-/*****************************************************************************/
-template<typename T>
-struct IDataObj
-{
-    virtual ~IDataObj() noexcept = default;
-
-    virtual void remove(void) noexcept = 0;
-    virtual void restore(void) noexcept = 0;
-    virtual void erase(void) noexcept = 0;
-
-    T *_l{ nullptr }, *_r{ nullptr }, *_u{ nullptr }, *_d{ nullptr };
-};
-
-/*****************************************************************************/
-struct Node : public IDataObj<Node>
-{
-    virtual void remove(void) noexcept override;
-    virtual void restore(void) noexcept override;
-    virtual void erase(void) noexcept override;
-
-    int     _row{ -1 };
-    Column* _col{ nullptr }; // Head
-};
+// Standard headers
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
 
-/*****************************************************************************/
-struct Column : public IDataObj<Column>
-{
-    virtual void remove(void) noexcept override;
-    virtual void restore(void) noexcept override;
-    virtual void erase(void) noexcept override;
+namespace ecv {
 
-public:
-    Node _head;    // Head
-    int  _size;    // Number of ones in the column, used for branching optimization
-    bool _primary; // Does it correspond to an essential or optional constraint
-};
+namespace detail {
 
 /*****************************************************************************/
 void
@@ -111,31 +78,10 @@ Column::erase(void) noexcept
     _r->_l = _l;
 }
 
-} // anonymous
-
-struct DLX::Impl
-{
-    Column              _head;
-    std::vector<Column> _cols;
-    std::vector<Node>   _nodes;
-
-    std::vector<Solution> _solutions;
-    std::vector<int>      _curSol;
-
-    Column*               col_select(void) noexcept;
-    [[maybe_unused]] bool init(const std::vector<bool>& data,
-                               size_t                   R,
-                               size_t                   C,
-                               const std::vector<int>&  rowsList,
-                               int                      primary) noexcept;
-    std::vector<Solution> solve(uint32_t) noexcept;
-    bool                  _solve(const uint32_t&, uint32_t&) noexcept;
-
-    auto zeros(void) noexcept { return (_head._r == &_head) && (_head._l == &_head); }
-};
+} // namespace detail
 
 /*****************************************************************************/
-Column*
+detail::Column*
 DLX::Impl::col_select(void) noexcept
 {
     auto ret{ _head._r };
@@ -149,25 +95,93 @@ DLX::Impl::col_select(void) noexcept
 
 /*****************************************************************************/
 bool
-DLX::Impl::init(const std::vector<bool>& data,
-                size_t                   R,
-                size_t                   C,
-                const std::vector<int>&  rowsList,
-                int                      primary) noexcept
+DLX::Impl::init(const std::vector<bool>&     data,
+                size_t                       R,
+                size_t                       C,
+                const std::pmr::vector<int>& rowsList,
+                int                          primary) noexcept
 {
     if (0 == R || 0 == C || std::size(data) != R * C)
         return false;
 
-    if (0 > primary)
-        primary = C;
+    // Compress the dense matrix so that only its non-zero entries get a node
+    std::pmr::vector<uint64_t> offsets{ _resource };
+    std::pmr::vector<uint32_t> indices{ _resource };
+    offsets.reserve(R + 1);
+    offsets.push_back(0);
+
+    for (size_t i{ 0 }, k{ 0 }; i < R; ++i) {
+        for (size_t j{ 0 }; j < C; ++j, ++k)
+            if (data[k])
+                indices.push_back(j);
+        offsets.push_back(std::size(indices));
+    }
+
+    return init(SparseMatrix{ R, C, primary, offsets.data(), indices.data() }, rowsList);
+}
+
+/*****************************************************************************/
+bool
+DLX::Impl::init(const SparseMatrix& m, const std::pmr::vector<int>& rowsList) noexcept
+{
+    auto R{ m._rows }, C{ m._cols };
+    if (0 == R || 0 == C || nullptr == m._offsets || 0 != m._offsets[0])
+        return false;
+
+    // Validate the whole matrix before allocating anything
+    for (size_t i{ 0 }; i < R; ++i) {
+        if (m._offsets[i + 1] < m._offsets[i])
+            return false;
+        for (auto k{ m._offsets[i] }; k < m._offsets[i + 1]; ++k) {
+            if (m._indices[k] >= C)
+                return false;
+            if (k > m._offsets[i] && m._indices[k] <= m._indices[k - 1])
+                return false;
+        }
+    }
+
+    auto primary{ (0 > m._primary || static_cast<size_t>(m._primary) > C) ? static_cast<int>(C)
+                                                                          : m._primary };
 
     // Either rows ids are not provided, or incomplete
     // In both case, use indexes instead.
     bool rowsIdByIdx{ std::empty(rowsList) || (R != std::size(rowsList)) };
 
+    _matrix._rows = R;
+    _matrix._cols = C;
+    _matrix._primary = primary;
+    _matrix._offsets.assign(m._offsets, m._offsets + R + 1);
+    _matrix._indices.assign(m._indices, m._indices + m._offsets[R]);
+    _matrix._rowIds.resize(R);
+    for (size_t i{ 0 }; i < R; ++i)
+        _matrix._rowIds[i] = rowsIdByIdx ? i : rowsList[i];
+
     _curSol.reserve(R);
+    link(Layout::Input);
+
+    return true;
+}
+
+/*****************************************************************************/
+void
+DLX::Impl::link(Layout layout) noexcept
+{
+    auto        R{ _matrix._rows }, C{ _matrix._cols };
+    const auto& offsets{ _matrix._offsets };
+    const auto& indices{ _matrix._indices };
+
+    // Memory position of the first node of every row.
+    // Columns always stay in the input order : it is the one col_select scans them in.
+    std::pmr::vector<uint64_t> rowPos(R, _resource);
+    if (Layout::Locality == layout)
+        locality(rowPos);
+    else
+        std::copy_n(std::begin(offsets), R, std::begin(rowPos));
+
+    _cols.clear();
     _cols.resize(C);
-    _nodes.resize(R * C);
+    _nodes.clear();
+    _nodes.resize(offsets[R]);
 
     _head._r = &_cols[0];
     _head._l = &_cols[C - 1];
@@ -175,76 +189,120 @@ DLX::Impl::init(const std::vector<bool>& data,
     _cols[0]._l = &_head;
     _cols[C - 1]._r = &_head;
 
-    for (size_t i{ 0 }; i < C - 1; ++i) {
-        _cols[i]._r = &_cols[i + 1];
-        _cols[i + 1]._l = &_cols[i];
+    for (size_t j{ 0 }; j < C - 1; ++j) {
+        _cols[j]._r = &_cols[j + 1];
+        _cols[j + 1]._l = &_cols[j];
     }
 
-    for (size_t i{ 0 }; i < C; ++i) {
-        _cols[i]._size = R;
-        _cols[i]._primary = (static_cast<int>(i) < primary);
+    for (size_t j{ 0 }; j < C; ++j) {
+        _cols[j]._head._u = &_cols[j]._head;
+        _cols[j]._head._d = &_cols[j]._head;
+        _cols[j]._size = 0;
+        _cols[j]._primary = (j < _matrix._primary);
     }
 
-    for (size_t i{ 0 }, k{ 0 }; i < R; ++i) {
-        for (size_t j{ 0 }; j < C; ++j, ++k) {
-            if (k < C)
-                _cols[j]._head._d = &_nodes[k];
-            if (k >= (R - 1) * C)
-                _cols[j]._head._u = &_nodes[k];
-
-            _nodes[k]._row = rowsIdByIdx ? i : rowsList[i];
-            _nodes[k]._col = &_cols[j];
-
-            _nodes[k]._l = (0 == k % C) ? &_nodes[k + C - 1] : &_nodes[k - 1];
-            _nodes[k]._r = (C - 1 == k % C) ? &_nodes[k - C + 1] : &_nodes[k + 1];
-            _nodes[k]._u = (k < C) ? &_cols[j]._head : &_nodes[k - C];
-            _nodes[k]._d = (k >= (R - 1) * C) ? &_cols[j]._head : &_nodes[k + C];
+    // Whatever their place in memory, rows are linked in the input order : every row is appended
+    // at the bottom of its columns, and its nodes are contiguous
+    for (size_t i{ 0 }; i < R; ++i) {
+        auto first{ rowPos[i] }, size{ offsets[i + 1] - offsets[i] };
+        for (uint64_t k{ 0 }; k < size; ++k) {
+            auto& node{ _nodes[first + k] };
+            auto& column{ _cols[indices[offsets[i] + k]] };
+
+            node._row = _matrix._rowIds[i];
+            node._col = &column;
+
+            node._l = (0 == k) ? &_nodes[first + size - 1] : &_nodes[first + k - 1];
+            node._r = (size - 1 == k) ? &_nodes[first] : &_nodes[first + k + 1];
+            node._u = column._head._u;
+            node._d = &column._head;
+
+            column._head._u->_d = &node;
+            column._head._u = &node;
+            ++column._size;
         }
     }
-
-    for (size_t i{ 0 }, k{ 0 }; i < R; ++i)
-        for (size_t j{ 0 }; j < C; ++j, ++k)
-            if (!data[k])
-                _nodes[k].erase();
-
-    return true;
 }
 
 /*****************************************************************************/
-std::vector<DLX::Solution>
+std::pmr::vector<DLX::Solution>
 DLX::Impl::solve(uint32_t max_solutions = std::numeric_limits<uint32_t>::max()) noexcept
 {
-    uint32_t sol_count{ 0 };
+    uint64_t sol_count{ 0 };
     _solutions.clear();
 
-    if (!std::empty(_nodes))
+    if (_learn)
+        learn(max_solutions);
+    else if (!std::empty(_nodes))
         _solve(max_solutions, sol_count);
-    return _solutions;
+    return std::move(_solutions); // Keeps its memory resource
 }
 
 /*****************************************************************************/
-DLX::DLX(const std::vector<bool>& data,
-         size_t                   rows,
-         size_t                   cols,
-         const std::vector<int>&  rowsList,
-         int                      primary) noexcept
-  : pimpl{ std::make_shared<Impl>() }
+uint64_t
+DLX::Impl::count(uint64_t max_solutions) noexcept
+{
+    uint64_t sol_count{ 0 };
+
+    _store = false;
+    if (_learn)
+        sol_count = learn(max_solutions);
+    else if (!std::empty(_nodes))
+        _solve(max_solutions, sol_count);
+    _store = true;
+
+    return sol_count;
+}
+
+/*****************************************************************************/
+uint64_t
+DLX::Impl::enumerate(const Visitor& f, uint64_t max_solutions) noexcept
+{
+    _visitor = &f;
+    auto ret{ count(max_solutions) };
+    _visitor = nullptr;
+
+    return ret;
+}
+
+/*****************************************************************************/
+DLX::DLX(const std::vector<bool>&     data,
+         size_t                       rows,
+         size_t                       cols,
+         const std::pmr::vector<int>& rowsList,
+         int                          primary,
+         std::pmr::memory_resource*   resource) noexcept
+  : pimpl{ std::allocate_shared<Impl>(std::pmr::polymorphic_allocator<Impl>{ resource }, resource) }
 {
     pimpl->init(data, rows, cols, rowsList, primary);
 }
 
+/*****************************************************************************/
+DLX::DLX(const SparseMatrix&          m,
+         const std::pmr::vector<int>& rowsList,
+         std::pmr::memory_resource*   resource) noexcept
+  : pimpl{ std::allocate_shared<Impl>(std::pmr::polymorphic_allocator<Impl>{ resource }, resource) }
+{
+    pimpl->init(m, rowsList);
+}
+
 /*****************************************************************************/
 bool
-DLX::Impl::_solve(const uint32_t& max_solutions, uint32_t& sol_count) noexcept
+DLX::Impl::_solve(const uint64_t& max_solutions, uint64_t& sol_count) noexcept
 {
     if (max_solutions == sol_count)
         return true;
+    if (nullptr != _control && !_control->visit())
+        return false; // Cancelled
 
     // Apply DLX algorithm (recursive, non-deterministic)
 
     // No more primary constraints, only optionals. We are good to go
     if (!_head._r->_primary || zeros()) { // success
-        _solutions.emplace_back(_curSol);
+        if (_store)
+            _solutions.emplace_back(_curSol);
+        else if (nullptr != _visitor)
+            (*_visitor)(_curSol);
         ++sol_count;
         return true;
     }
@@ -256,61 +314,230 @@ DLX::Impl::_solve(const uint32_t& max_solutions, uint32_t& sol_count) noexcept
     // The recursive dance
     curCol->remove();
     for (auto cRow{ curCol->_head._d }; &curCol->_head != cRow; cRow = cRow->_d) {
-        for (auto cCol{ cRow->_r }; cRow != cCol; cCol = cCol->_r) {
+        _curSol.push_back(cRow->_row);
+        for (auto cCol{ cRow->_r }; cRow != cCol; cCol = cCol->_r)
             cCol->_col->remove();
-            _curSol.push_back(cCol->_row);
-        }
 
         _solve(max_solutions, sol_count);
 
-        for (auto cCol{ cRow->_l }; cRow != cCol; cCol = cCol->_l) {
+        for (auto cCol{ cRow->_l }; cRow != cCol; cCol = cCol->_l)
             cCol->_col->restore();
-            _curSol.pop_back();
-        }
+        _curSol.pop_back();
+
+        if (max_solutions == sol_count)
+            break;
     }
     curCol->restore();
     return false;
 }
 
 /*****************************************************************************/
-std::vector<DLX::Solution>
+std::pmr::vector<DLX::Solution>
 DLX::solve(uint32_t max_solutions) noexcept
 {
+    detail::Exclusive search{ pimpl->_busy };
+    if (!search)
+        return std::pmr::vector<Solution>{ pimpl->_resource };
+
+    if (Engine::Cells == _engine) {
+        std::pmr::vector<Solution> ret{ pimpl->_resource };
+        pimpl->_cells->solve(max_solutions,
+                             [&ret](const std::pmr::vector<int>& sol) { ret.emplace_back(sol); });
+        return ret;
+    }
+
     return pimpl->solve(max_solutions);
 }
 
+/*****************************************************************************/
+uint64_t
+DLX::count(uint64_t max_solutions) noexcept
+{
+    detail::Exclusive search{ pimpl->_busy };
+    if (!search)
+        return 0;
+
+    if (Engine::Cells == _engine)
+        return pimpl->_cells->solve(max_solutions, nullptr);
+
+    return pimpl->count(max_solutions);
+}
+
+/*****************************************************************************/
+uint64_t
+DLX::enumerate(const Visitor& f, uint64_t max_solutions) noexcept
+{
+    detail::Exclusive search{ pimpl->_busy };
+    if (!search)
+        return 0;
+
+    // The visitor may stop the search (\see SolutionWriter)
+    detail::Control control{};
+    pimpl->_control = &control;
+    auto ret{ (Engine::Cells == _engine) ? pimpl->_cells->solve(max_solutions, f, &control)
+                                         : pimpl->enumerate(f, max_solutions) };
+    pimpl->_control = nullptr;
+
+    return ret;
+}
+
+/*****************************************************************************/
+void
+DLX::stop(void) noexcept
+{
+    if (nullptr != pimpl && nullptr != pimpl->_control)
+        pimpl->_control->stop();
+}
+
+/*****************************************************************************/
+Bounds
+DLX::bounds(void) const noexcept
+{
+    Bounds   ret{};
+    uint64_t primary{ 0 }, narrowest{ std::numeric_limits<uint64_t>::max() };
+    for (const auto& col : pimpl->_cols)
+        primary += col._primary ? 1 : 0;
+    for (const auto& node : pimpl->_nodes) {
+        ret._largest = std::max<uint64_t>(ret._largest, std::abs(static_cast<int64_t>(node._row)));
+
+        // Every row once, from its first node in memory
+        uint64_t width{ node._col->_primary ? 1u : 0u };
+        auto     first{ true };
+        for (auto n{ node._r }; &node != n && first; n = n->_r) {
+            first = (&node < n);
+            width += n->_col->_primary ? 1 : 0;
+        }
+        if (first && 0 != width)
+            narrowest = std::min(narrowest, width);
+    }
+    ret._rows = (0 == primary) ? 0 : primary / narrowest;
+    return ret;
+}
+
+/*****************************************************************************/
+bool
+DLX::set_engine(Engine engine) noexcept
+{
+    detail::Exclusive search{ pimpl->_busy };
+    if (!search)
+        return false;
+
+    switch (engine) {
+        case Engine::Links:
+        case Engine::Learning:
+            break;
+        case Engine::Cells:
+            // Nodes of the sparse sets are indexed on 32 bits
+            if (std::numeric_limits<uint32_t>::max() <= std::size(pimpl->_matrix._indices))
+                return false;
+            if (nullptr == pimpl->_cells)
+                pimpl->_cells = std::allocate_shared<detail::Cells>(
+                  std::pmr::polymorphic_allocator<detail::Cells>{ pimpl->_resource },
+                  pimpl->_matrix,
+                  pimpl->_resource);
+            break;
+        default:
+            return false;
+    }
+
+    use_engine(engine);
+    return true;
+}
+
+/*****************************************************************************/
+void
+DLX::use_engine(Engine engine) noexcept
+{
+    _engine = engine;
+    pimpl->_learn = (Engine::Learning == engine);
+}
+
+/*****************************************************************************/
+Learning
+DLX::learning(void) const noexcept
+{
+    return pimpl->_learning;
+}
+
+/*****************************************************************************/
+bool
+DLX::set_layout(Layout layout) noexcept
+{
+    detail::Exclusive search{ pimpl->_busy };
+    if (!search || std::empty(pimpl->_nodes))
+        return false;
+
+    pimpl->link(layout);
+    pimpl->_nodeCost = 0; // Timed again for the new layout
+    _layout = layout;
+    return true;
+}
+
+/*****************************************************************************/
+std::pmr::memory_resource*
+DLX::resource(void) const noexcept
+{
+    return pimpl->_resource;
+}
+
 /*****************************************************************************/
 std::unique_ptr<GenericProblem>
-GenericProblem::generate(const std::vector<bool>& data,
-                         size_t                   rows,
-                         size_t                   cols,
-                         int                      primary) noexcept
+GenericProblem::generate(const std::vector<bool>&   data,
+                         size_t                     rows,
+                         size_t                     cols,
+                         int                        primary,
+                         std::pmr::memory_resource* resource) noexcept
 {
     struct shared_enabler : public GenericProblem
     {
-        shared_enabler(const std::vector<bool>& data, size_t rows, size_t cols, int primary)
-          : GenericProblem(data, rows, cols, primary)
+        shared_enabler(const std::vector<bool>&   data,
+                       size_t                     rows,
+                       size_t                     cols,
+                       int                        primary,
+                       std::pmr::memory_resource* resource)
+          : GenericProblem(data, rows, cols, primary, resource)
         {}
     };
 
-    return std::make_unique<shared_enabler>(data, rows, cols, primary);
+    return std::make_unique<shared_enabler>(data, rows, cols, primary, resource);
 }
 
 /*****************************************************************************/
-GenericProblem::GenericProblem(const std::vector<bool>& data,
-                               size_t                   rows,
-                               size_t                   cols,
-                               int                      primary) noexcept
-  : DLX(data, rows, cols, {}, primary)
+std::unique_ptr<GenericProblem>
+GenericProblem::generate(const SparseMatrix& m, std::pmr::memory_resource* resource) noexcept
+{
+    struct shared_enabler : public GenericProblem
+    {
+        shared_enabler(const SparseMatrix& m, std::pmr::memory_resource* resource)
+          : GenericProblem(m, resource)
+        {}
+    };
+
+    auto ret{ std::make_unique<shared_enabler>(m, resource) };
+    if (std::empty(ret->pimpl->_cols))
+        return nullptr;
+    return ret;
+}
+
+/*****************************************************************************/
+GenericProblem::GenericProblem(const std::vector<bool>&   data,
+                               size_t                     rows,
+                               size_t                     cols,
+                               int                        primary,
+                               std::pmr::memory_resource* resource) noexcept
+  : DLX(data, rows, cols, std::pmr::vector<int>{ resource }, primary, resource)
+{}
+
+/*****************************************************************************/
+GenericProblem::GenericProblem(const SparseMatrix& m, std::pmr::memory_resource* resource) noexcept
+  : DLX(m, std::pmr::vector<int>{ resource }, resource)
 {}
 
 /*****************************************************************************/
-ConcreteProblem::ConcreteProblem(const std::vector<bool>& data,
-                                 size_t                   rows,
-                                 size_t                   cols,
-                                 const std::vector<int>&  rowsList,
-                                 int                      primary) noexcept
-  : DLX(data, rows, cols, rowsList, primary)
+ConcreteProblem::ConcreteProblem(const SparseMatrix&          m,
+                                 const std::pmr::vector<int>& rowsList,
+                                 std::pmr::memory_resource*   resource) noexcept
+  : DLX(m, rowsList, resource)
 {}
 
 } // namespace ecv
@@ -0,0 +1,157 @@
+/**
+ * @file estimate.cpp
+ * @brief Implementation of the search tree estimation part of \a ecv.hpp
+ * @author lhm
+ */
+
+// Project's headers
+#include "links.hpp"
+
+// Standard headers
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+namespace ecv {
+
+namespace {
+constexpr double   Z95{ 1.959964 };      // Quantile of the normal distribution for a 95% interval
+constexpr uint64_t CALIBRATION{ 100000 }; // Nodes of the search timed to get the cost of a node
+
+/*****************************************************************************/
+class Stats
+{ ///< Running mean and variance of the probes (Welford's algorithm)
+public:
+    void add(double x) noexcept
+    {
+        auto delta{ x - _mean };
+        _mean += delta / ++_n;
+        _m2 += delta * (x - _mean);
+    }
+
+    Estimate::Value value(double scale, double floor) const noexcept
+    {
+        auto half{ (1 < _n) ? Z95 * std::sqrt(_m2 / (_n - 1) / _n) : 0. };
+        return { scale * _mean, scale * std::max(floor, _mean - half), scale * (_mean + half) };
+    }
+
+private:
+    uint64_t _n{ 0 };
+    double   _mean{ 0 }, _m2{ 0 };
+};
+
+/*****************************************************************************/
+template<typename Links>
+void
+search(Links& impl, uint64_t& budget) noexcept
+{ // Same as the DLX search, stopped after a given number of nodes
+    if (0 == budget)
+        return;
+
+    --budget;
+    if (!impl._head._r->_primary || impl.zeros())
+        return;
+
+    auto curCol{ impl.col_select() };
+    if (0 == curCol->_size)
+        return;
+
+    curCol->remove();
+    for (auto cRow{ curCol->_head._d }; &curCol->_head != cRow && 0 != budget; cRow = cRow->_d) {
+        for (auto cCol{ cRow->_r }; cRow != cCol; cCol = cCol->_r)
+            cCol->_col->remove();
+
+        search(impl, budget);
+
+        for (auto cCol{ cRow->_l }; cRow != cCol; cCol = cCol->_l)
+            cCol->_col->restore();
+    }
+    curCol->restore();
+}
+
+} // anonymous
+
+/*****************************************************************************/
+Estimate
+DLX::Impl::estimate(uint32_t probes, uint64_t seed) noexcept
+{
+    Estimate ret{};
+    if (std::empty(_nodes) || 0 == probes)
+        return ret;
+
+    std::mt19937_64            rng{ seed };
+    std::vector<detail::Node*> path{};
+    Stats                      nodes{}, solutions{};
+    path.reserve(std::size(_cols));
+
+    for (uint32_t p{ 0 }; p < probes; ++p) {
+        // Walk down a random path : a node at depth k stands for the product of the branching
+        // factors above it, since the search would have visited as many of them
+        double weight{ 1 }, size{ 1 }, found{ 0 };
+        for (;;) {
+            if (!_head._r->_primary || zeros()) { // success
+                found = weight;
+                break;
+            }
+
+            auto curCol{ col_select() };
+            if (0 == curCol->_size) // failure
+                break;
+
+            weight *= curCol->_size;
+            size += weight;
+
+            auto cRow{ curCol->_head._d };
+            for (auto k{ std::uniform_int_distribution<int>{ 0, curCol->_size - 1 }(rng) }; 0 < k;
+                 --k)
+                cRow = cRow->_d;
+
+            curCol->remove();
+            for (auto cCol{ cRow->_r }; cRow != cCol; cCol = cCol->_r)
+                cCol->_col->remove();
+            path.push_back(cRow);
+        }
+
+        // Then back to the root
+        for (; !std::empty(path); path.pop_back()) {
+            auto cRow{ path.back() };
+            for (auto cCol{ cRow->_l }; cRow != cCol; cCol = cCol->_l)
+                cCol->_col->restore();
+            cRow->_col->restore();
+        }
+
+        nodes.add(size);
+        solutions.add(found);
+    }
+
+    // Probes are slower than the search (random accesses, unwinding), so time a bit of it instead,
+    // once for all : the cost of a node only depends on the problem and its layout
+    if (0 == _nodeCost) {
+        uint64_t budget{ CALIBRATION };
+        auto     start{ std::chrono::steady_clock::now() };
+        search(*this, budget);
+        auto elapsed{ std::chrono::duration<double>(std::chrono::steady_clock::now() - start) };
+        if (CALIBRATION != budget)
+            _nodeCost = elapsed.count() / (CALIBRATION - budget);
+    }
+
+    ret._nodes = nodes.value(1, 1);
+    ret._solutions = solutions.value(1, 0);
+    ret._seconds = nodes.value(_nodeCost, 1);
+    ret._probes = probes;
+    return ret;
+}
+
+/*****************************************************************************/
+Estimate
+DLX::estimate(uint32_t probes, uint64_t seed) noexcept
+{
+    detail::Exclusive search{ pimpl->_busy };
+    if (!search)
+        return Estimate{};
+
+    return pimpl->estimate(probes, seed);
+}
+
+} // namespace ecv
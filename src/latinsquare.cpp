@@ -18,29 +18,53 @@ LatinSquares::make_empty_state(size_t rows, size_t cols) noexcept
 
 /*****************************************************************************/
 std::unique_ptr<LatinSquares>
-LatinSquares::generate(const State& state) noexcept
+LatinSquares::generate(const State& state, std::pmr::memory_resource* resource) noexcept
 {
+    auto N{ std::size(state) };
+
+    std::pmr::string grid{ resource };
+    grid.reserve(N * N);
+    for (const auto& line : state) {
+        if (N != std::size(line))
+            return nullptr;
+        grid += line;
+    }
+
+    return parse(grid, resource);
+}
+
+/*****************************************************************************/
+std::unique_ptr<LatinSquares>
+LatinSquares::parse(std::string_view grid, std::pmr::memory_resource* resource) noexcept
+{
+    size_t N{ 0 };
+    while ((N + 1) * (N + 1) <= std::size(grid))
+        ++N;
+    if (N * N != std::size(grid))
+        return nullptr;
+
     // Initial adjacency matrix dimensions ( without constraints )
     // - rows refer to the possible placements (placing a number in a cell : N * N * N)
     // - cols refer to the constraints
     //    - 1 number per cell (N * N)
     //    - each number once per row (N * N)
     //    - each number once per col (N * N)
-    auto N{ std::size(state) }, rows{ N * N * N }, cols{ 3 * N * N };
-
-    for (const auto& line : state)
-        if (N != std::size(line))
-            return nullptr;
+    auto rows{ N * N * N }, cols{ 3 * N * N };
 
     // Constraints ( non-zero nodes on provided inputs )
-    auto authRows{ std::vector<int>(rows, 1) }, authCols{ std::vector<int>(cols, 1) };
+    std::pmr::vector<int> authRows(rows, 1, resource), authCols(cols, 1, resource);
+    std::pmr::string      initGrid(N * N, '0', resource);
 
     for (size_t i{ 0 }; i < N; ++i) {
         for (size_t j{ 0 }; j < N; ++j) {
-            auto val{ state[i][j] - '0' };
+            auto val{ ('.' == grid[i * N + j]) ? 0 : grid[i * N + j] - '0' };
+            if (0 > val || static_cast<int>(N) < val)
+                return nullptr;
             if (0 == val)
                 continue; // No constraint on the node
 
+            initGrid[i * N + j] = grid[i * N + j];
+
             for (size_t k{ 0 }; k < N; ++k) {
                 authRows[i * N * N + j * N + k] = 0;       // cannot put any val in the cell
                 authRows[i * N * N + k * N + val - 1] = 0; // cannot put val in the line
@@ -59,8 +83,12 @@ LatinSquares::generate(const State& state) noexcept
     for (size_t i{ 0 }; i < cols; ++i)
         authCols[i] = authCols[i] ? C++ : -1;
 
-    auto             adj{ std::vector<bool>(R * C, false) };
-    std::vector<int> rowsList{};
+    // Every row has at most 3 non-zero entries, one per constraint type (in increasing order)
+    std::pmr::vector<uint64_t> offsets(1, 0, resource);
+    std::pmr::vector<uint32_t> indices{ resource };
+    std::pmr::vector<int>      rowsList{ resource };
+    offsets.reserve(R + 1);
+    indices.reserve(3 * R);
     rowsList.reserve(R);
 
     for (size_t i{ 0 }; i < N; ++i) {
@@ -71,61 +99,66 @@ LatinSquares::generate(const State& state) noexcept
                     continue;
                 rowsList.push_back(r);
                 size_t c1{ i * N + j }, c2{ N * N + i * N + k }, c3{ 2 * N * N + j * N + k };
-                if (authCols[c1] != -1)
-                    adj[authRows[r] * C + authCols[c1]] = true;
-                if (authCols[c2] != -1)
-                    adj[authRows[r] * C + authCols[c2]] = true;
-                if (authCols[c3] != -1)
-                    adj[authRows[r] * C + authCols[c3]] = true;
+                for (auto c : { c1, c2, c3 })
+                    if (authCols[c] != -1)
+                        indices.push_back(authCols[c]);
+                offsets.push_back(std::size(indices));
             }
         }
     }
 
     struct shared_enabler : public LatinSquares
     {
-        shared_enabler(const std::vector<bool>& data,
-                       size_t                   rows,
-                       size_t                   cols,
-                       const std::vector<int>&  rowsList,
-                       const State&             state)
-          : LatinSquares(data, rows, cols, rowsList, state)
+        shared_enabler(const SparseMatrix&          m,
+                       const std::pmr::vector<int>& rowsList,
+                       std::string_view             initGrid,
+                       size_t                       dim,
+                       std::pmr::memory_resource*   resource)
+          : LatinSquares(m, rowsList, initGrid, dim, resource)
         {}
     };
 
-    return std::make_unique<shared_enabler>(adj, R, C, rowsList, state);
+    return std::make_unique<shared_enabler>(
+      SparseMatrix{ R, C, -1, offsets.data(), indices.data() }, rowsList, initGrid, N, resource);
 }
 
 /*****************************************************************************/
-LatinSquares::LatinSquares(const std::vector<bool>& data,
-                           size_t                   rows,
-                           size_t                   cols,
-                           const std::vector<int>&  rowsList,
-                           const State&             initStata) noexcept
-  : ConcreteProblem(data, rows, cols, rowsList)
-  , _initState{ initStata }
+LatinSquares::LatinSquares(const SparseMatrix&          m,
+                           const std::pmr::vector<int>& rowsList,
+                           std::string_view             initGrid,
+                           size_t                       dim,
+                           std::pmr::memory_resource*   resource) noexcept
+  : ConcreteProblem(m, rowsList, resource)
+  , _initGrid{ initGrid, resource }
+  , _dim{ dim }
 {}
 
 /*****************************************************************************/
 State
 LatinSquares::apply(const Solution& s) noexcept
 {
-    auto ret{ _initState };
+    std::string grid{};
+    apply(s, grid);
 
-    if (std::empty(ret))
-        return ret;
+    State ret{};
+    ret.reserve(_dim);
+    for (size_t i{ 0 }; i < _dim; ++i)
+        ret.emplace_back(grid, i * _dim, _dim);
 
-    auto R{ std::size(_initState) }, C{ std::size(_initState[0]) };
+    return ret;
+}
 
-    for (const auto& line : s._d) {
-        if (static_cast<size_t>(line) > R * R * C)
-            return ret;
-        auto pos{ line / R };
-        auto val{ (line % R) + 1 };
+/*****************************************************************************/
+void
+LatinSquares::apply(const Solution& s, std::string& grid) const noexcept
+{
+    grid.assign(_initGrid);
 
-        ret[pos / C][pos % C] = (0 == val) ? R + '0' : val + '0';
+    for (const auto& line : s._d) {
+        if (static_cast<size_t>(line) >= _dim * _dim * _dim)
+            return;
+        grid[line / _dim] = (line % _dim) + '1';
     }
-
-    return ret;
 }
 
 } // namespace ecv
@@ -0,0 +1,87 @@
+/**
+ * @file layout.cpp
+ * @brief Implementation of the memory layout part of \a ecv.hpp
+ * @author lhm
+ */
+
+// Project's headers
+#include "links.hpp"
+
+// Standard headers
+#include <algorithm>
+
+namespace ecv {
+
+/*****************************************************************************/
+void
+DLX::Impl::locality(std::pmr::vector<uint64_t>& rowPos) const noexcept
+{
+    auto        R{ _matrix._rows }, C{ _matrix._cols };
+    const auto& offsets{ _matrix._offsets };
+    const auto& indices{ _matrix._indices };
+    auto        width{ [&offsets](uint32_t i) { return offsets[i + 1] - offsets[i]; } };
+
+    // Rows of every column
+    std::pmr::vector<uint64_t> start(C + 1, 0, _resource);
+    std::pmr::vector<uint32_t> rows(std::size(indices), _resource);
+    for (auto j : indices)
+        ++start[j + 1];
+    for (size_t j{ 0 }; j < C; ++j)
+        start[j + 1] += start[j];
+    {
+        std::pmr::vector<uint64_t> next(std::begin(start), std::end(start) - 1, _resource);
+        for (uint32_t i{ 0 }; i < R; ++i)
+            for (auto k{ offsets[i] }; k < offsets[i + 1]; ++k)
+                rows[next[indices[k]]++] = i;
+    }
+
+    // Reverse Cuthill-McKee : breadth-first search over the rows sharing a column, starting from
+    // the narrowest rows and visiting the neighbours of every row from the narrowest one.
+    // Every column is expanded once, so that it runs in linear time.
+    std::pmr::vector<uint32_t> seeds(R, _resource), order{ _resource };
+    std::pmr::vector<char>     rowSeen(R, false, _resource), colSeen(C, false, _resource);
+    for (uint32_t i{ 0 }; i < R; ++i)
+        seeds[i] = i;
+    std::stable_sort(std::begin(seeds), std::end(seeds), [&width](uint32_t a, uint32_t b) {
+        return width(a) < width(b);
+    });
+
+    order.reserve(R);
+    for (auto seed : seeds) {
+        if (rowSeen[seed])
+            continue;
+        rowSeen[seed] = true;
+        order.push_back(seed);
+
+        for (size_t h{ std::size(order) - 1 }; h < std::size(order); ++h) {
+            auto i{ order[h] };
+            auto level{ std::size(order) };
+            for (auto k{ offsets[i] }; k < offsets[i + 1]; ++k) {
+                auto j{ indices[k] };
+                if (colSeen[j])
+                    continue;
+                colSeen[j] = true;
+
+                for (auto p{ start[j] }; p < start[j + 1]; ++p) {
+                    if (!rowSeen[rows[p]]) {
+                        rowSeen[rows[p]] = true;
+                        order.push_back(rows[p]);
+                    }
+                }
+            }
+            std::stable_sort(std::begin(order) + level,
+                             std::end(order),
+                             [&width](uint32_t a, uint32_t b) { return width(a) < width(b); });
+        }
+    }
+    std::reverse(std::begin(order), std::end(order));
+
+    // Rows are then stored in that order
+    uint64_t next{ 0 };
+    for (auto i : order) {
+        rowPos[i] = next;
+        next += width(i);
+    }
+}
+
+} // namespace ecv
@@ -0,0 +1,381 @@
+/**
+ * @file learn.cpp
+ * @brief Implementation of the conflict-driven search part of \a ecv.hpp
+ * @author lhm
+ */
+
+// Project's headers
+#include "links.hpp"
+
+// Standard headers
+#include <algorithm>
+
+namespace ecv {
+
+namespace {
+constexpr uint32_t NONE{ std::numeric_limits<uint32_t>::max() }; // Row visible, or not chosen
+constexpr size_t   MAX_NOGOOD{ 16 };                // Larger nogoods are seldom met again
+constexpr size_t   MAX_ENTRIES{ size_t{ 1 } << 22 }; // Rows of all the nogoods kept
+
+/*****************************************************************************/
+template<typename Links>
+class Learner
+{ ///< Dancing links search explaining its failures by the levels that hid rows
+public:
+    explicit Learner(Links& impl) noexcept;
+
+    uint64_t solve(uint64_t max_solutions) noexcept;
+
+private:
+    bool search(uint32_t t) noexcept;
+    void cover(detail::Column* col, uint32_t t) noexcept;
+    void uncover(detail::Column* col) noexcept;
+    void explain(const detail::Column* col, std::pmr::vector<uint64_t>& conf) const noexcept;
+    void choose(uint32_t r, uint32_t t) noexcept;
+    void unchoose(uint32_t r, uint32_t t) noexcept;
+    void forbid(uint32_t r, uint32_t id, uint32_t l) noexcept;
+    bool pruned(uint32_t r, std::pmr::vector<uint64_t>& conf) const noexcept;
+    void learn(const std::pmr::vector<uint64_t>& conf, uint32_t t) noexcept;
+
+    uint32_t row(const detail::Node* n) const noexcept
+    {
+        return _rowOf[n - std::data(_impl._nodes)];
+    }
+
+    static void set(std::pmr::vector<uint64_t>& conf, uint32_t l) noexcept
+    {
+        conf[l / 64] |= uint64_t{ 1 } << (l % 64);
+    }
+    static bool test(const std::pmr::vector<uint64_t>& conf, uint32_t l) noexcept
+    {
+        return 0 != (conf[l / 64] & (uint64_t{ 1 } << (l % 64)));
+    }
+
+    template<typename T>
+    using Table = std::pmr::vector<std::pmr::vector<T>>; // Inner vectors share the resource
+
+    // Every table is allocated from the memory resource of the problem
+    Links&                     _impl;
+    std::pmr::vector<uint32_t> _rowOf;           // Row of every node
+    std::pmr::vector<uint32_t> _start, _colRows; // Rows of every column
+    std::pmr::vector<uint32_t> _hiddenAt;        // Level whose covers hid every row
+    std::pmr::vector<uint32_t> _chosenAt;        // Level every row is chosen at
+    std::pmr::vector<uint32_t> _path;            // Row chosen at every level
+
+    // Conflict of the node at every depth : the levels (above it) its failure comes from
+    Table<uint64_t> _conf;
+
+    // Rows of every nogood, the first two being watched : a nogood is only looked at when one
+    // of them is chosen, to watch another row, or else to forbid the last one not chosen
+    std::pmr::vector<uint32_t>           _nogoods, _nogoodStart;
+    Table<uint32_t>                      _watch;   // Nogoods watching every row
+    Table<uint32_t>                      _forbids; // Nogoods forbidding every row
+    Table<std::pair<uint32_t, uint32_t>> _trail;   // Forbids of every level
+
+    uint64_t _max{ 0 }, _count{ 0 };
+    bool     _stop{ false }; // Enough solutions, cancelled, or unsatisfiable
+};
+
+/*****************************************************************************/
+template<typename Links>
+Learner<Links>::Learner(Links& impl) noexcept
+  : _impl{ impl }
+  , _rowOf(std::size(impl._nodes), NONE, impl._resource)
+  , _start{ impl._resource }
+  , _colRows{ impl._resource }
+  , _hiddenAt{ impl._resource }
+  , _chosenAt{ impl._resource }
+  , _path{ impl._resource }
+  , _conf{ impl._resource }
+  , _nogoods{ impl._resource }
+  , _nogoodStart(1, 0, impl._resource)
+  , _watch{ impl._resource }
+  , _forbids{ impl._resource }
+  , _trail{ impl._resource }
+{
+    // Rows are numbered following their nodes
+    auto     nodes{ std::data(impl._nodes) };
+    uint32_t R{ 0 };
+    for (size_t k{ 0 }; k < std::size(impl._nodes); ++k) {
+        if (NONE != _rowOf[k])
+            continue;
+        _rowOf[k] = R;
+        for (auto n{ nodes[k]._r }; &nodes[k] != n; n = n->_r)
+            _rowOf[n - nodes] = R;
+        ++R;
+    }
+
+    // Rows of every column, to explain why it lacks some of them
+    auto C{ std::size(impl._cols) };
+    _start.assign(C + 1, 0);
+    _colRows.resize(std::size(impl._nodes));
+    for (const auto& n : impl._nodes)
+        ++_start[n._col - std::data(impl._cols) + 1];
+    for (size_t j{ 0 }; j < C; ++j)
+        _start[j + 1] += _start[j];
+    {
+        std::pmr::vector<uint32_t> next(std::begin(_start), std::end(_start) - 1, impl._resource);
+        for (size_t k{ 0 }; k < std::size(impl._nodes); ++k)
+            _colRows[next[nodes[k]._col - std::data(impl._cols)]++] = _rowOf[k];
+    }
+
+    _hiddenAt.assign(R, NONE);
+    _chosenAt.assign(R, NONE);
+    _path.assign(C + 1, NONE);
+    _conf.resize(C + 2); // Every level covers a column : never resized (nor moved) by the search
+    _watch.resize(R);
+    _forbids.resize(R);
+    _trail.resize(C + 1);
+}
+
+/*****************************************************************************/
+template<typename Links>
+void
+Learner<Links>::cover(detail::Column* col, uint32_t t) noexcept
+{
+    col->_l->_r = col->_r;
+    col->_r->_l = col->_l;
+
+    for (auto ccell{ col->_head._d }; ccell != &col->_head; ccell = ccell->_d) {
+        _hiddenAt[row(ccell)] = t;
+        for (auto rcell{ ccell->_r }; rcell != ccell; rcell = rcell->_r)
+            rcell->remove();
+    }
+}
+
+/*****************************************************************************/
+template<typename Links>
+void
+Learner<Links>::uncover(detail::Column* col) noexcept
+{
+    for (auto ccell{ col->_head._u }; ccell != &col->_head; ccell = ccell->_u) {
+        for (auto rcell{ ccell->_l }; rcell != ccell; rcell = rcell->_l)
+            rcell->restore();
+        _hiddenAt[row(ccell)] = NONE;
+    }
+
+    col->_l->_r = col;
+    col->_r->_l = col;
+}
+
+/*****************************************************************************/
+template<typename Links>
+void
+Learner<Links>::explain(const detail::Column* col, std::pmr::vector<uint64_t>& conf) const noexcept
+{
+    // A row hidden from the column shares a column with the row chosen at the level hiding it
+    size_t j = col - std::data(_impl._cols);
+    for (auto k{ _start[j] }; k < _start[j + 1]; ++k)
+        if (auto l{ _hiddenAt[_colRows[k]] }; NONE != l)
+            set(conf, l);
+}
+
+/*****************************************************************************/
+template<typename Links>
+void
+Learner<Links>::forbid(uint32_t r, uint32_t id, uint32_t l) noexcept
+{
+    _forbids[r].push_back(id);
+    if (NONE != l)
+        _trail[l].emplace_back(r, id); // Until the row chosen at that level is not anymore
+}
+
+/*****************************************************************************/
+template<typename Links>
+void
+Learner<Links>::choose(uint32_t r, uint32_t t) noexcept
+{
+    _path[t] = r;
+    _chosenAt[r] = t;
+
+    auto& watch{ _watch[r] };
+    for (size_t i{ 0 }; i < std::size(watch);) {
+        auto id{ watch[i] };
+        auto rows{ std::data(_nogoods) + _nogoodStart[id] };
+        auto size{ _nogoodStart[id + 1] - _nogoodStart[id] };
+        if (rows[1] == r)
+            std::swap(rows[0], rows[1]);
+
+        auto k{ 2u };
+        while (k < size && NONE != _chosenAt[rows[k]])
+            ++k;
+        if (k < size) {
+            std::swap(rows[0], rows[k]);
+            _watch[rows[0]].push_back(id);
+            watch[i] = watch.back();
+            watch.pop_back();
+        } else {
+            if (NONE == _chosenAt[rows[1]])
+                forbid(rows[1], id, t);
+            ++i;
+        }
+    }
+}
+
+/*****************************************************************************/
+template<typename Links>
+void
+Learner<Links>::unchoose(uint32_t r, uint32_t t) noexcept
+{
+    auto& trail{ _trail[t] };
+    for (auto it{ std::rbegin(trail) }; it != std::rend(trail); ++it) {
+        auto& forbids{ _forbids[it->first] };
+        forbids.erase(std::find(std::rbegin(forbids), std::rend(forbids), it->second).base() - 1);
+    }
+    trail.clear();
+    _chosenAt[r] = NONE;
+}
+
+/*****************************************************************************/
+template<typename Links>
+bool
+Learner<Links>::pruned(uint32_t r, std::pmr::vector<uint64_t>& conf) const noexcept
+{
+    if (std::empty(_forbids[r]))
+        return false;
+
+    // Every other row of the nogood is chosen
+    auto id{ _forbids[r].back() };
+    for (auto k{ _nogoodStart[id] }; k < _nogoodStart[id + 1]; ++k)
+        if (_nogoods[k] != r)
+            set(conf, _chosenAt[_nogoods[k]]);
+    return true;
+}
+
+/*****************************************************************************/
+template<typename Links>
+void
+Learner<Links>::learn(const std::pmr::vector<uint64_t>& conf, uint32_t t) noexcept
+{
+    size_t size{ 0 };
+    for (uint32_t w{ 0 }; w <= t / 64; ++w)
+        size += __builtin_popcountll(conf[w]);
+
+    if (0 == size) {
+        _stop = true; // No earlier choice involved : no solution is left
+        return;
+    }
+    if (MAX_NOGOOD < size || MAX_ENTRIES < std::size(_nogoods) + size)
+        return;
+
+    // Its rows are all chosen : watch the two last ones, the deepest being forbidden as soon as
+    // the search goes back above it
+    uint32_t id = std::size(_nogoodStart) - 1;
+    for (auto l{ t }; l-- > 0;)
+        if (test(conf, l))
+            _nogoods.push_back(_path[l]);
+    _nogoodStart.push_back(std::size(_nogoods));
+    ++_impl._learning._nogoods;
+
+    auto rows{ std::data(_nogoods) + _nogoodStart[id] };
+    if (1 == size) {
+        forbid(rows[0], id, NONE);
+        return;
+    }
+    _watch[rows[0]].push_back(id);
+    _watch[rows[1]].push_back(id);
+    forbid(rows[0], id, _chosenAt[rows[1]]);
+}
+
+/*****************************************************************************/
+template<typename Links>
+bool
+Learner<Links>::search(uint32_t t) noexcept
+{ // Returns false on failure, its conflict being in _conf[t]
+    ++_impl._learning._nodes;
+    if (nullptr != _impl._control && !_impl._control->visit()) {
+        _stop = true;
+        return true;
+    }
+
+    if (!_impl._head._r->_primary || _impl.zeros()) { // success
+        if (_impl._store)
+            _impl._solutions.emplace_back(_impl._curSol);
+        else if (nullptr != _impl._visitor)
+            (*_impl._visitor)(_impl._curSol);
+        _stop = (_max == ++_count);
+        return true;
+    }
+
+    auto& conf{ _conf[t] };
+    conf.assign(t / 64 + 1, 0);
+
+    auto curCol{ _impl.col_select() };
+    explain(curCol, conf);
+    if (0 == curCol->_size) { // failure
+        learn(conf, t);
+        return false;
+    }
+
+    auto found{ false };
+    cover(curCol, t);
+    for (auto cRow{ curCol->_head._d }; &curCol->_head != cRow && !_stop; cRow = cRow->_d) {
+        auto r{ row(cRow) };
+        if (pruned(r, conf)) {
+            ++_impl._learning._pruned;
+            continue;
+        }
+
+        choose(r, t);
+        _impl._curSol.push_back(cRow->_row);
+        for (auto cCol{ cRow->_r }; cRow != cCol; cCol = cCol->_r)
+            cover(cCol->_col, t);
+
+        auto ok{ search(t + 1) };
+
+        for (auto cCol{ cRow->_l }; cRow != cCol; cCol = cCol->_l)
+            uncover(cCol->_col);
+        _impl._curSol.pop_back();
+        unchoose(r, t);
+
+        if (ok) {
+            found = true;
+            continue;
+        }
+
+        const auto& child{ _conf[t + 1] };
+        if (!test(child, t)) {
+            // The row is not involved in the failure : neither would its siblings be
+            ++_impl._learning._backjumps;
+            if (found)
+                break;
+            std::copy_n(std::begin(child), std::size(conf), std::begin(conf));
+            uncover(curCol);
+            return false;
+        }
+        for (size_t w{ 0 }; w < std::size(conf); ++w)
+            conf[w] |= child[w];
+        conf[t / 64] &= ~(uint64_t{ 1 } << (t % 64));
+    }
+    uncover(curCol);
+
+    if (found || _stop)
+        return true;
+    learn(conf, t);
+    return false;
+}
+
+/*****************************************************************************/
+template<typename Links>
+uint64_t
+Learner<Links>::solve(uint64_t max_solutions) noexcept
+{
+    _max = max_solutions;
+    if (0 != _max)
+        search(0);
+    return _count;
+}
+} // namespace
+
+/*****************************************************************************/
+uint64_t
+DLX::Impl::learn(uint64_t max_solutions) noexcept
+{
+    _learning = {};
+    if (std::empty(_nodes))
+        return 0;
+
+    return Learner<Impl>{ *this }.solve(max_solutions);
+}
+
+} // namespace ecv
@@ -0,0 +1,165 @@
+/**
+ * @file links.hpp
+ * @brief Dancing links engine of the ecv library
+ * @author lhm
+ */
+
+#ifndef SRC_LINKS_HPP
+#define SRC_LINKS_HPP
+
+// Project's headers
+#include "cells.hpp"
+
+// Standard headers
+#include <atomic>
+
+namespace ecv {
+
+namespace detail {
+struct Column;
+
+/*****************************************************************************/
+template<typename T>
+struct IDataObj
+{
+    virtual ~IDataObj() noexcept = default;
+
+    virtual void remove(void) noexcept = 0;
+    virtual void restore(void) noexcept = 0;
+    virtual void erase(void) noexcept = 0;
+
+    T *_l{ nullptr }, *_r{ nullptr }, *_u{ nullptr }, *_d{ nullptr };
+};
+
+/*****************************************************************************/
+struct Node : public IDataObj<Node>
+{
+    virtual void remove(void) noexcept override;
+    virtual void restore(void) noexcept override;
+    virtual void erase(void) noexcept override;
+
+    int     _row{ -1 };
+    Column* _col{ nullptr }; // Head
+};
+
+/*****************************************************************************/
+struct Column : public IDataObj<Column>
+{
+    virtual void remove(void) noexcept override;
+    virtual void restore(void) noexcept override;
+    virtual void erase(void) noexcept override;
+
+public:
+    Node _head;    // Head
+    int  _size;    // Number of ones in the column, used for branching optimization
+    bool _primary; // Does it correspond to an essential or optional constraint
+};
+
+/*****************************************************************************/
+struct Control
+{ // Shared by a search with its asynchronous handle, or given to its visitor
+    std::atomic<bool>     _cancel{ false };
+    std::atomic<uint64_t> _nodes{ 0 };
+    uint64_t              _count{ 0 };       // Nodes, only published from time to time
+    bool                  _stopped{ false }; // Cancel seen by the search
+
+    bool visit(void) noexcept
+    {
+        if (!_stopped && 0 == (++_count & 1023)) {
+            _nodes.store(_count, std::memory_order_relaxed);
+            _stopped = _cancel.load(std::memory_order_relaxed);
+        }
+        return !_stopped;
+    }
+
+    void stop(void) noexcept { _stopped = true; } // From the search thread (its visitor)
+};
+
+/*****************************************************************************/
+class Exclusive
+{ ///< Use of the nodes by one search at a time : refused while another one runs on them
+public:
+    explicit Exclusive(std::atomic<bool>& busy) noexcept
+      : _busy{ busy }
+      , _owner{ !busy.exchange(true, std::memory_order_acquire) }
+    {}
+    ~Exclusive() noexcept
+    {
+        if (_owner)
+            _busy.store(false, std::memory_order_release);
+    }
+
+    Exclusive(const Exclusive&) = delete;
+    Exclusive& operator=(const Exclusive&) = delete;
+
+    explicit operator bool() const noexcept { return _owner; }
+
+private:
+    std::atomic<bool>& _busy;
+    const bool         _owner;
+};
+
+} // namespace detail
+
+struct DLX::Impl
+{
+    explicit Impl(std::pmr::memory_resource* resource) noexcept
+      : _resource{ resource }
+      , _cols{ resource }
+      , _nodes{ resource }
+      , _matrix{ resource }
+      , _solutions{ resource }
+      , _curSol{ resource }
+    {}
+
+    std::pmr::memory_resource*       _resource; // Every structure below is allocated from it
+    detail::Column                   _head;
+    std::pmr::vector<detail::Column> _cols;
+    std::pmr::vector<detail::Node>   _nodes;
+
+    detail::Matrix                 _matrix; // Problem definition, to build the other engines
+    std::shared_ptr<detail::Cells> _cells{ nullptr };
+
+    std::pmr::vector<Solution> _solutions;
+    std::pmr::vector<int>      _curSol;
+    bool                       _store{ true };      // Keep the solutions, or only count them
+    const Visitor*             _visitor{ nullptr }; // Given the solutions that are not kept
+    detail::Control*           _control{ nullptr }; // Progress of an asynchronous search
+    std::atomic<bool>          _busy{ false };      // A search runs (\see detail::Exclusive)
+    bool                       _learn{ false };     // Search with Engine::Learning
+    Learning                   _learning{};         // Work of its last search
+    double                     _nodeCost{ 0 };      // Seconds per node, timed by estimate
+
+    detail::Column*       col_select(void) noexcept;
+    [[maybe_unused]] bool init(const std::vector<bool>&     data,
+                               size_t                       R,
+                               size_t                       C,
+                               const std::pmr::vector<int>& rowsList,
+                               int                          primary) noexcept;
+    [[maybe_unused]] bool init(const SparseMatrix&          m,
+                               const std::pmr::vector<int>& rowsList) noexcept;
+    void                       link(Layout layout) noexcept;
+    std::pmr::vector<Solution> solve(uint32_t) noexcept;
+    uint64_t                   count(uint64_t) noexcept;
+    uint64_t                   enumerate(const Visitor&, uint64_t) noexcept;
+    bool                       _solve(const uint64_t&, uint64_t&) noexcept;
+
+    // Conflict-driven search (\see learn.cpp)
+    uint64_t learn(uint64_t max_solutions) noexcept;
+
+    // Sub-problems memoization (\see memo.cpp)
+    uint64_t count_memoized(size_t max_memory) noexcept;
+    Zdd      zdd(size_t max_memory) noexcept;
+
+    // Memory layout of the nodes (\see layout.cpp)
+    void locality(std::pmr::vector<uint64_t>& rowPos) const noexcept;
+
+    // Search tree size estimation (\see estimate.cpp)
+    Estimate estimate(uint32_t probes, uint64_t seed) noexcept;
+
+    auto zeros(void) noexcept { return (_head._r == &_head) && (_head._l == &_head); }
+};
+
+} // namespace ecv
+
+#endif // SRC_LINKS_HPP
@@ -0,0 +1,48 @@
+/**
+ * @file matrix.hpp
+ * @brief Adjacency matrix storage shared by the engines of the ecv library
+ * @author lhm
+ */
+
+#ifndef SRC_MATRIX_HPP
+#define SRC_MATRIX_HPP
+
+// Project's headers
+#include <ecv.hpp>
+
+namespace ecv {
+namespace detail {
+
+/*!
+ * \brief Matrix owns a copy of a CSR adjacency matrix, along with its rows identifiers.
+ * It allows engines to be (re)built from the problem definition.
+ */
+struct Matrix
+{
+    explicit Matrix(std::pmr::memory_resource* resource) noexcept
+      : _offsets{ resource }
+      , _indices{ resource }
+      , _rowIds{ resource }
+    {}
+
+    size_t                     _rows{ 0 };
+    size_t                     _cols{ 0 };
+    size_t                     _primary{ 0 };
+    std::pmr::vector<uint64_t> _offsets;
+    std::pmr::vector<uint32_t> _indices;
+    std::pmr::vector<int>      _rowIds;
+
+    SparseMatrix view(void) const noexcept
+    {
+        return { _rows,
+                 _cols,
+                 static_cast<int>(_primary),
+                 std::data(_offsets),
+                 std::data(_indices) };
+    }
+};
+
+} // namespace detail
+} // namespace ecv
+
+#endif // SRC_MATRIX_HPP
@@ -0,0 +1,319 @@
+/**
+ * @file memo.cpp
+ * @brief Implementation of the sub-problems memoization part of \a ecv.hpp
+ * @author lhm
+ */
+
+// Project's headers
+#include "links.hpp"
+
+// Standard headers
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+namespace ecv {
+
+namespace {
+/*****************************************************************************/
+uint64_t
+saturatedAdd(uint64_t a, uint64_t b) noexcept
+{
+    return (a > std::numeric_limits<uint64_t>::max() - b) ? std::numeric_limits<uint64_t>::max()
+                                                          : a + b;
+}
+
+/*****************************************************************************/
+uint64_t
+splitmix64(uint64_t& state) noexcept
+{
+    auto z{ (state += 0x9E3779B97F4A7C15ull) };
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/*****************************************************************************/
+class Memo
+{ ///< Bounded open-addressing cache, from a set of active columns to a value
+public:
+    Memo(size_t words, size_t max_memory) noexcept
+      : _words{ words }
+      , _maxSlots{ std::max<size_t>(max_memory / (2 * sizeof(uint64_t) + words * sizeof(uint64_t)),
+                                    1) }
+    {
+        rehash(std::min<size_t>(1024, floorPow2(_maxSlots)));
+    }
+
+    const uint64_t* find(uint64_t hash, const std::vector<uint64_t>& key) const noexcept
+    {
+        for (auto i{ hash & (_capacity - 1) }; 0 != _hashes[i]; i = (i + 1) & (_capacity - 1))
+            if (hash == _hashes[i] &&
+                0 == std::memcmp(&_keys[i * _words], key.data(), _words * sizeof(uint64_t)))
+                return &_values[i];
+        return nullptr;
+    }
+
+    void insert(uint64_t hash, const std::vector<uint64_t>& key, uint64_t value) noexcept
+    {
+        if (4 * (_size + 1) > 3 * _capacity) { // Keep the load factor under 0.75
+            if (2 * _capacity > _maxSlots)
+                return; // Memory bound reached
+            rehash(2 * _capacity);
+        }
+
+        auto i{ hash & (_capacity - 1) };
+        while (0 != _hashes[i])
+            i = (i + 1) & (_capacity - 1);
+
+        _hashes[i] = hash;
+        _values[i] = value;
+        std::copy(std::begin(key), std::end(key), std::begin(_keys) + i * _words);
+        ++_size;
+    }
+
+private:
+    static size_t floorPow2(size_t n) noexcept
+    {
+        size_t ret{ 1 };
+        while (2 * ret <= n)
+            ret *= 2;
+        return ret;
+    }
+
+    void rehash(size_t capacity) noexcept
+    {
+        std::vector<uint64_t> hashes(capacity, 0), values(capacity), keys(capacity * _words);
+        for (size_t j{ 0 }; j < _capacity; ++j) {
+            if (0 == _hashes[j])
+                continue;
+
+            auto i{ _hashes[j] & (capacity - 1) };
+            while (0 != hashes[i])
+                i = (i + 1) & (capacity - 1);
+            hashes[i] = _hashes[j];
+            values[i] = _values[j];
+            std::copy_n(std::begin(_keys) + j * _words, _words, std::begin(keys) + i * _words);
+        }
+
+        _capacity = capacity;
+        _hashes.swap(hashes);
+        _values.swap(values);
+        _keys.swap(keys);
+    }
+
+    const size_t          _words;
+    const size_t          _maxSlots;
+    size_t                _capacity{ 0 }, _size{ 0 };
+    std::vector<uint64_t> _hashes{}; // 0 marks an empty slot
+    std::vector<uint64_t> _values{};
+    std::vector<uint64_t> _keys{};
+};
+
+/*****************************************************************************/
+template<typename Links>
+class Search
+{ ///< Memoized search over the dancing links, the sub-problems being their active columns
+public:
+    Search(Links& impl, size_t max_memory) noexcept
+      : _impl{ impl }
+      , _words{ (std::size(impl._cols) + 63) / 64 }
+      , _active(_words, 0)
+      , _zobrist(std::size(impl._cols))
+      , _memo{ _words, max_memory }
+    {
+        uint64_t seed{ 0 };
+        for (size_t c{ 0 }; c < std::size(_zobrist); ++c) {
+            _zobrist[c] = splitmix64(seed);
+            _active[c / 64] |= uint64_t{ 1 } << (c % 64);
+            _hash ^= _zobrist[c];
+        }
+    }
+
+    uint64_t count(void) noexcept;
+    uint32_t zdd(Zdd& z) noexcept;
+
+private:
+    void remove(detail::Column* col) noexcept
+    {
+        size_t c = col - std::data(_impl._cols);
+        _active[c / 64] ^= uint64_t{ 1 } << (c % 64);
+        _hash ^= _zobrist[c];
+        col->remove();
+    }
+
+    void restore(detail::Column* col) noexcept
+    {
+        size_t c = col - std::data(_impl._cols);
+        col->restore();
+        _active[c / 64] ^= uint64_t{ 1 } << (c % 64);
+        _hash ^= _zobrist[c];
+    }
+
+    uint64_t key(void) const noexcept { return _hash | 1; } // 0 marks empty slots
+
+    Links&                _impl;
+    const size_t          _words;
+    std::vector<uint64_t> _active;  // Bitset of the active columns
+    std::vector<uint64_t> _zobrist; // Random value of every column, xored into _hash
+    uint64_t              _hash{ 0 };
+    Memo                  _memo;
+
+    struct NodeHash
+    {
+        size_t operator()(const Zdd::Node& n) const noexcept
+        {
+            return (static_cast<uint64_t>(n._row) * 0x9E3779B97F4A7C15ull) ^
+                   (static_cast<uint64_t>(n._lo) << 32) ^ n._hi;
+        }
+    };
+    struct NodeEqual
+    {
+        bool operator()(const Zdd::Node& a, const Zdd::Node& b) const noexcept
+        {
+            return a._row == b._row && a._lo == b._lo && a._hi == b._hi;
+        }
+    };
+    std::unordered_map<Zdd::Node, uint32_t, NodeHash, NodeEqual> _unique{};
+};
+
+/*****************************************************************************/
+template<typename Links>
+uint64_t
+Search<Links>::count(void) noexcept
+{
+    auto& head{ _impl._head };
+    if (!head._r->_primary || _impl.zeros())
+        return 1;
+
+    if (auto cached{ _memo.find(key(), _active) }; nullptr != cached)
+        return *cached;
+
+    auto curCol{ _impl.col_select() };
+    if (0 == curCol->_size)
+        return 0;
+
+    uint64_t ret{ 0 };
+    remove(curCol);
+    for (auto cRow{ curCol->_head._d }; &curCol->_head != cRow; cRow = cRow->_d) {
+        for (auto cCol{ cRow->_r }; cRow != cCol; cCol = cCol->_r)
+            remove(cCol->_col);
+
+        ret = saturatedAdd(ret, count());
+
+        for (auto cCol{ cRow->_l }; cRow != cCol; cCol = cCol->_l)
+            restore(cCol->_col);
+    }
+    restore(curCol);
+
+    _memo.insert(key(), _active, ret);
+    return ret;
+}
+
+/*****************************************************************************/
+template<typename Links>
+uint32_t
+Search<Links>::zdd(Zdd& z) noexcept
+{
+    auto& head{ _impl._head };
+    if (!head._r->_primary || _impl.zeros())
+        return Zdd::TOP;
+
+    if (auto cached{ _memo.find(key(), _active) }; nullptr != cached)
+        return *cached;
+
+    auto curCol{ _impl.col_select() };
+    if (0 == curCol->_size)
+        return Zdd::BOTTOM;
+
+    // Solutions of the sub-problem left by every row of the column
+    std::vector<std::pair<int, uint32_t>> branches{};
+    remove(curCol);
+    for (auto cRow{ curCol->_head._d }; &curCol->_head != cRow; cRow = cRow->_d) {
+        for (auto cCol{ cRow->_r }; cRow != cCol; cCol = cCol->_r)
+            remove(cCol->_col);
+
+        if (auto hi{ zdd(z) }; Zdd::BOTTOM != hi)
+            branches.emplace_back(cRow->_row, hi);
+
+        for (auto cCol{ cRow->_l }; cRow != cCol; cCol = cCol->_l)
+            restore(cCol->_col);
+    }
+    restore(curCol);
+
+    // Chain them through their '_lo' branches, sharing identical nodes
+    auto ret{ Zdd::BOTTOM };
+    for (auto it{ std::rbegin(branches) }; std::rend(branches) != it; ++it) {
+        Zdd::Node node{ it->first, ret, it->second };
+        auto [pos, inserted]{ _unique.emplace(node, std::size(z._nodes)) };
+        if (inserted)
+            z._nodes.push_back(node);
+        ret = pos->second;
+    }
+
+    _memo.insert(key(), _active, ret);
+    return ret;
+}
+
+} // anonymous
+
+/*****************************************************************************/
+uint64_t
+DLX::Impl::count_memoized(size_t max_memory) noexcept
+{
+    if (std::empty(_nodes))
+        return 0;
+
+    return Search<Impl>{ *this, max_memory }.count();
+}
+
+/*****************************************************************************/
+Zdd
+DLX::Impl::zdd(size_t max_memory) noexcept
+{
+    Zdd ret{};
+    ret._nodes = { { -1, Zdd::BOTTOM, Zdd::BOTTOM }, { -1, Zdd::TOP, Zdd::TOP } };
+
+    if (!std::empty(_nodes))
+        ret._root = Search<Impl>{ *this, max_memory }.zdd(ret);
+    return ret;
+}
+
+/*****************************************************************************/
+uint64_t
+Zdd::count(void) const noexcept
+{
+    // Children always come before their parents
+    std::vector<uint64_t> counts(std::size(_nodes), 0);
+    if (TOP < std::size(_nodes))
+        counts[TOP] = 1;
+
+    for (size_t i{ TOP + 1 }; i < std::size(_nodes); ++i)
+        counts[i] = saturatedAdd(counts[_nodes[i]._lo], counts[_nodes[i]._hi]);
+
+    return (_root < std::size(counts)) ? counts[_root] : 0;
+}
+
+/*****************************************************************************/
+uint64_t
+DLX::count_memoized(size_t max_memory) noexcept
+{
+    detail::Exclusive search{ pimpl->_busy };
+    if (!search)
+        return 0;
+
+    return pimpl->count_memoized(max_memory);
+}
+
+/*****************************************************************************/
+Zdd
+DLX::zdd(size_t max_memory) noexcept
+{
+    detail::Exclusive search{ pimpl->_busy };
+    if (!search)
+        return Zdd{};
+
+    return pimpl->zdd(max_memory);
+}
+
+} // namespace ecv
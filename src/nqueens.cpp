@@ -5,10 +5,281 @@
  */
 
 // Project's headers
-#include <ecv.hpp>
+#include "links.hpp"
+
+// Standard headers
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
 
 namespace ecv {
 
+namespace {
+/*****************************************************************************/
+template<typename Task>
+void
+parallel(size_t nbTasks, Task&& task) noexcept
+{
+    std::atomic<size_t> next{ 0 };
+    auto                run{ [&]() {
+        for (size_t i{ next++ }; i < nbTasks; i = next++)
+            task(i);
+    } };
+
+    auto nbThreads{ std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), nbTasks) };
+    std::vector<std::thread> threads{};
+    for (size_t i{ 1 }; i < nbThreads; ++i)
+        threads.emplace_back(run);
+    run();
+
+    for (auto& t : threads)
+        t.join();
+}
+
+/*****************************************************************************/
+class Bitboard
+{ ///< Row by row N-Queens backtracking, using bitmasks for the attacked columns and diagonals
+public:
+    Bitboard(std::string_view grid, size_t dim) noexcept;
+
+    uint64_t                      count(uint64_t max_solutions) const noexcept;
+    std::vector<std::vector<int>> solve(uint64_t max_solutions) const noexcept;
+    template<typename F>
+    uint64_t enumerate(uint64_t max_solutions, F& f) const noexcept;
+
+private:
+    struct Masks
+    {
+        uint64_t _cols{ 0 }, _ld{ 0 }, _rd{ 0 };
+
+        Masks place(uint64_t b) const noexcept
+        {
+            return { _cols | b, (_ld | b) << 1, (_rd | b) >> 1 };
+        }
+    };
+
+    uint64_t avail(int row, const Masks& m) const noexcept
+    {
+        auto ret{ _full & ~(m._cols | m._ld | m._rd | _blocked[row]) };
+        return (-1 == _preset[row]) ? ret : ret & (uint64_t{ 1 } << _preset[row]);
+    }
+
+    uint64_t countFrom(int row, const Masks& m) const noexcept;
+    template<typename F>
+    bool solveFrom(int row, const Masks& m, std::vector<int>& path, F& f) const noexcept;
+
+    // The search is split over the placements (tasks) of the first row without pre-placed queen.
+    // When the board is mirror-symmetric, only the left half of them has to be explored.
+    size_t nbTasks(void) const noexcept { return _mirror ? (_n + 1) / 2 : _n; }
+    bool   mirrored(size_t task) const noexcept { return _mirror && 2 * task + 1 != size_t(_n); }
+
+    int                   _n{ 0 };
+    uint64_t              _full{ 0 };
+    std::vector<int>      _preset{};  // Column of the pre-placed queen of every row (-1 if none)
+    std::vector<uint64_t> _blocked{}; // Cells of every row attacked by pre-placed queens
+    bool                  _valid{ true };
+    bool                  _mirror{ true };
+    int                   _first{ 0 }; // First row without pre-placed queen
+    Masks                 _start{};    // Masks on reaching the first row without pre-placed queen
+};
+
+/*****************************************************************************/
+Bitboard::Bitboard(std::string_view grid, size_t dim) noexcept
+  : _n(dim)
+  , _full{ (64 == _n) ? ~uint64_t{ 0 } : (uint64_t{ 1 } << _n) - 1 }
+  , _preset(_n, -1)
+  , _blocked(_n, 0)
+{
+    for (int i{ 0 }; i < _n; ++i) {
+        for (int j{ 0 }; j < _n; ++j) {
+            if ('0' == grid[i * _n + j])
+                continue;
+            _valid = _valid && (-1 == _preset[i]);
+            _preset[i] = j;
+            _mirror = _mirror && (2 * j + 1 == _n);
+        }
+    }
+
+    for (int i{ 0 }; i < _n; ++i) {
+        if (-1 == _preset[i])
+            continue;
+        for (int k{ 0 }; k < _n; ++k) {
+            if (k == i)
+                continue;
+            auto d{ std::abs(k - i) }, j{ _preset[i] };
+            _blocked[k] |= (uint64_t{ 1 } << j);
+            if (j + d < _n)
+                _blocked[k] |= (uint64_t{ 1 } << (j + d));
+            if (j - d >= 0)
+                _blocked[k] |= (uint64_t{ 1 } << (j - d));
+        }
+    }
+
+    for (int i{ 0 }; i < _n; ++i)
+        if (-1 != _preset[i] && 0 != (_blocked[i] & (uint64_t{ 1 } << _preset[i])))
+            _valid = false; // Pre-placed queens attacking each other
+
+    while (_first < _n && -1 != _preset[_first])
+        _start = _start.place(uint64_t{ 1 } << _preset[_first++]);
+
+    // Like the DLX algorithm, a board without free row has no solution
+    _valid = _valid && _first < _n;
+}
+
+/*****************************************************************************/
+uint64_t
+Bitboard::countFrom(int row, const Masks& m) const noexcept
+{
+    if (_n == row)
+        return 1;
+
+    uint64_t ret{ 0 };
+    for (auto a{ avail(row, m) }; 0 != a; a &= a - 1)
+        ret += countFrom(row + 1, m.place(a & -a));
+    return ret;
+}
+
+/*****************************************************************************/
+template<typename F>
+bool
+Bitboard::solveFrom(int row, const Masks& m, std::vector<int>& path, F& f) const noexcept
+{
+    if (_n == row)
+        return f(path);
+
+    for (auto a{ avail(row, m) }; 0 != a; a &= a - 1) {
+        auto b{ a & -a };
+        if (-1 == _preset[row])
+            path.push_back(row * _n + __builtin_ctzll(b));
+        auto goOn{ solveFrom(row + 1, m.place(b), path, f) };
+        if (-1 == _preset[row])
+            path.pop_back();
+        if (!goOn)
+            return false;
+    }
+    return true;
+}
+
+/*****************************************************************************/
+uint64_t
+Bitboard::count(uint64_t max_solutions) const noexcept
+{
+    if (!_valid || 0 == max_solutions)
+        return 0;
+
+    std::atomic<uint64_t> total{ 0 };
+    auto                  bounded{ std::numeric_limits<uint64_t>::max() != max_solutions };
+
+    parallel(nbTasks(), [&](size_t task) {
+        auto b{ uint64_t{ 1 } << task };
+        if (0 == (avail(_first, _start) & b))
+            return;
+
+        uint64_t weight{ mirrored(task) ? 2u : 1u };
+        if (!bounded) {
+            total += weight * countFrom(_first + 1, _start.place(b));
+            return;
+        }
+
+        // Stop every task as soon as enough solutions have been found
+        std::vector<int> path{};
+        auto             f{ [&](const std::vector<int>&) {
+            return (total += weight) < max_solutions;
+        } };
+        if (total < max_solutions)
+            solveFrom(_first + 1, _start.place(b), path, f);
+    });
+
+    return std::min<uint64_t>(total, max_solutions);
+}
+
+/*****************************************************************************/
+std::vector<std::vector<int>>
+Bitboard::solve(uint64_t max_solutions) const noexcept
+{
+    if (!_valid || 0 == max_solutions)
+        return {};
+
+    std::vector<std::vector<std::vector<int>>> found(nbTasks());
+    parallel(nbTasks(), [&](size_t task) {
+        auto b{ uint64_t{ 1 } << task };
+        if (0 == (avail(_first, _start) & b))
+            return;
+
+        std::vector<int> path{ static_cast<int>(_first * _n + task) };
+        auto             f{ [&](const std::vector<int>& p) {
+            found[task].push_back(p);
+            return std::size(found[task]) < max_solutions;
+        } };
+        solveFrom(_first + 1, _start.place(b), path, f);
+    });
+
+    // Gather the solutions by column of the first free row, mirroring the right half if needed
+    std::vector<std::vector<int>> ret{};
+    for (int c{ 0 }; c < _n && std::size(ret) < max_solutions; ++c) {
+        auto task{ static_cast<size_t>(c) };
+        if (nbTasks() <= task) {
+            task = _n - 1 - c;
+            if (!mirrored(task))
+                continue;
+        }
+
+        for (const auto& sol : found[task]) {
+            if (std::size(ret) == max_solutions)
+                break;
+            ret.push_back(sol);
+            if (task != static_cast<size_t>(c))
+                for (auto& r : ret.back())
+                    r = (r / _n) * _n + (_n - 1 - r % _n);
+        }
+    }
+
+    return ret;
+}
+
+/*****************************************************************************/
+template<typename F>
+uint64_t
+Bitboard::enumerate(uint64_t max_solutions, F& f) const noexcept
+{ // f is called by one search thread at a time, as soon as they find a solution
+    if (!_valid || 0 == max_solutions)
+        return 0;
+
+    std::mutex        mtx{};
+    uint64_t          total{ 0 }; // Under mtx
+    std::atomic<bool> stop{ false };
+    auto              visit{ [&](const std::vector<int>& p) {
+        std::lock_guard lock{ mtx };
+        if (!stop) {
+            ++total;
+            stop = !f(p) || max_solutions == total;
+        }
+        return !stop;
+    } };
+
+    parallel(nbTasks(), [&](size_t task) {
+        auto b{ uint64_t{ 1 } << task };
+        if (stop || 0 == (avail(_first, _start) & b))
+            return;
+
+        std::vector<int> path{ static_cast<int>(_first * _n + task) }, mirror{};
+        auto             g{ [&](const std::vector<int>& p) {
+            if (!visit(p) || !mirrored(task))
+                return !stop;
+            mirror = p;
+            for (auto& r : mirror)
+                r = (r / _n) * _n + (_n - 1 - r % _n);
+            return visit(mirror);
+        } };
+        solveFrom(_first + 1, _start.place(b), path, g);
+    });
+
+    return total;
+}
+
+} // anonymous
+
 /*****************************************************************************/
 State
 NQueens::make_empty_state(size_t dim) noexcept
@@ -18,7 +289,7 @@ NQueens::make_empty_state(size_t dim) noexcept
 
 /*****************************************************************************/
 std::unique_ptr<NQueens>
-NQueens::generate(const State& state) noexcept
+NQueens::generate(const State& state, std::pmr::memory_resource* resource) noexcept
 {
     // Initial adjacency matrix dimensions ( without constraints )
     // - rows refer to the possible placements (placing a Queen in a cell : N * N )
@@ -37,18 +308,24 @@ NQueens::generate(const State& state) noexcept
     if (2 > N)
         return nullptr;
 
-    for (const auto& line : state)
+    std::pmr::string grid{ resource };
+    grid.reserve(N * N);
+    for (const auto& line : state) {
         if (N != static_cast<int>(std::size(line)))
             return nullptr;
+        grid += line;
+    }
 
     // Constraints ( non-zero nodes on provided inputs )
-    auto authRows{ std::vector<int>(rows, 1) }, authCols{ std::vector<int>(cols, 1) };
+    std::pmr::vector<int> authRows(rows, 1, resource), authCols(cols, 1, resource);
 
     for (int i{ 0 }; i < N; ++i) {
         for (int j{ 0 }; j < N; ++j) {
-            auto val{ state[i][j] - '0' };
+            auto val{ grid[i * N + j] - '0' };
             if (0 == val)
                 continue; // No constraint on the node
+            if (0 == authRows[i * N + j])
+                return nullptr; // Attacked by a queen placed before
 
             primaryConstraints -= 2;
 
@@ -85,8 +362,12 @@ NQueens::generate(const State& state) noexcept
     for (auto i{ 0 }; i < cols; ++i)
         authCols[i] = authCols[i] ? C++ : -1;
 
-    auto             adj{ std::vector<bool>(R * C, false) };
-    std::vector<int> rowsList{};
+    // Every row has at most 4 non-zero entries, one per constraint type (in increasing order)
+    std::pmr::vector<uint64_t> offsets(1, 0, resource);
+    std::pmr::vector<uint32_t> indices{ resource };
+    std::pmr::vector<int>      rowsList{ resource };
+    offsets.reserve(R + 1);
+    indices.reserve(4 * R);
     rowsList.reserve(R);
 
     for (auto i{ 0 }; i < N; ++i) {
@@ -97,59 +378,145 @@ NQueens::generate(const State& state) noexcept
             rowsList.push_back(r);
             auto c1{ i }, c2{ N + j }, c3{ 2 * N + N - 2 + i - j }, c4{ 4 * (N - 1) + i + j };
             if (authCols[c1] != -1)
-                adj[authRows[r] * C + authCols[c1]] = true;
+                indices.push_back(authCols[c1]);
             if (authCols[c2] != -1)
-                adj[authRows[r] * C + authCols[c2]] = true;
+                indices.push_back(authCols[c2]);
             if (authCols[c3] != -1 && abs(i - j) < (N - 1))
-                adj[authRows[r] * C + authCols[c3]] = true;
+                indices.push_back(authCols[c3]);
             if (authCols[c4] != -1 && (0 != (i + j) && 2 * (N - 1) != (i + j)))
-                adj[authRows[r] * C + authCols[c4]] = true;
+                indices.push_back(authCols[c4]);
+            offsets.push_back(std::size(indices));
         }
     }
 
     struct shared_enabler : public NQueens
     {
-        shared_enabler(const std::vector<bool>& data,
-                       size_t                   rows,
-                       size_t                   cols,
-                       const std::vector<int>&  rowsList,
-                       const State&             state,
-                       int                      primary)
-          : NQueens(data, rows, cols, rowsList, state, primary)
+        shared_enabler(const SparseMatrix&          m,
+                       const std::pmr::vector<int>& rowsList,
+                       std::string_view             initGrid,
+                       size_t                       dim,
+                       std::pmr::memory_resource*   resource)
+          : NQueens(m, rowsList, initGrid, dim, resource)
         {}
     };
 
     // In the N-Queens problem, only columns/rows constraints are primary.
     // Diagonal constraints are secondary, meaning it cannot be satisfied more than one time
     // but can be left unsatisfied.
-    return std::make_unique<shared_enabler>(adj, R, C, rowsList, state, primaryConstraints);
+    return std::make_unique<shared_enabler>(
+      SparseMatrix{
+        size_t(R), size_t(C), primaryConstraints, std::data(offsets), std::data(indices) },
+      rowsList,
+      grid,
+      N,
+      resource);
 }
 
 /*****************************************************************************/
-NQueens::NQueens(const std::vector<bool>& data,
-                 size_t                   rows,
-                 size_t                   cols,
-                 const std::vector<int>&  rowsList,
-                 const State&             initStata,
-                 int                      primary) noexcept
-  : ConcreteProblem(data, rows, cols, rowsList, primary)
-  , _initState{ initStata }
+NQueens::NQueens(const SparseMatrix&          m,
+                 const std::pmr::vector<int>& rowsList,
+                 std::string_view             initGrid,
+                 size_t                       dim,
+                 std::pmr::memory_resource*   resource) noexcept
+  : ConcreteProblem(m, rowsList, resource)
+  , _initGrid{ initGrid, resource }
+  , _dim{ dim }
 {}
 
 /*****************************************************************************/
-State
-NQueens::apply(const Solution& s) noexcept
+bool
+NQueens::set_engine(Engine engine) noexcept
 {
-    auto ret{ _initState };
+    if (Engine::Bitboard != engine || 64 < _dim)
+        return DLX::set_engine(engine);
 
-    if (std::empty(ret))
-        return ret;
+    detail::Exclusive search{ pimpl->_busy };
+    if (!search)
+        return false;
 
-    auto R{ std::size(_initState) }, C{ std::size(_initState[0]) };
+    use_engine(engine);
+    return true;
+}
+
+/*****************************************************************************/
+std::pmr::vector<DLX::Solution>
+NQueens::solve(uint32_t max_solutions) noexcept
+{
+    {
+        detail::Exclusive search{ pimpl->_busy };
+        std::pmr::vector<Solution> ret{ resource() };
+        if (!search)
+            return ret;
+
+        if (Engine::Bitboard == _engine) {
+            // The search threads use the default resource : only the results are allocated from
+            // the problem one, which needs not be thread-safe
+            for (const auto& sol : Bitboard{ _initGrid, _dim }.solve(max_solutions))
+                ret.emplace_back(sol);
+            return ret;
+        }
+    }
+
+    return DLX::solve(max_solutions);
+}
+
+/*****************************************************************************/
+uint64_t
+NQueens::count(uint64_t max_solutions) noexcept
+{
+    {
+        detail::Exclusive search{ pimpl->_busy };
+        if (!search)
+            return 0;
+        if (Engine::Bitboard == _engine)
+            return Bitboard{ _initGrid, _dim }.count(max_solutions);
+    }
+
+    return DLX::count(max_solutions);
+}
+
+/*****************************************************************************/
+uint64_t
+NQueens::enumerate(const Visitor& f, uint64_t max_solutions) noexcept
+{
+    {
+        detail::Exclusive search{ pimpl->_busy };
+        if (!search)
+            return 0;
+
+        if (Engine::Bitboard == _engine) {
+            // Visited straight from the search threads, one at a time : the rows, and the control
+            // the visitor may stop the search through, are only used under the search lock
+            detail::Control       control{};
+            std::pmr::vector<int> rows{ resource() };
+            auto                  visit{ [&](const std::vector<int>& sol) {
+                rows.assign(std::begin(sol), std::end(sol));
+                f(rows);
+                return control.visit();
+            } };
+
+            pimpl->_control = &control;
+            auto ret{ Bitboard{ _initGrid, _dim }.enumerate(max_solutions, visit) };
+            pimpl->_control = nullptr;
+            return ret;
+        }
+    }
+
+    return DLX::enumerate(f, max_solutions);
+}
+
+/*****************************************************************************/
+State
+NQueens::apply(const Solution& s) noexcept
+{
+    State ret{};
+    ret.reserve(_dim);
+    for (size_t i{ 0 }; i < _dim; ++i)
+        ret.emplace_back(std::string_view{ _initGrid }.substr(i * _dim, _dim));
 
     for (const auto& line : s._d)
-        if (static_cast<size_t>(line) <= R * C)
-            ret[line / R][line % R] = '1';
+        if (static_cast<size_t>(line) < _dim * _dim)
+            ret[line / _dim][line % _dim] = '1';
 
     return ret;
 }
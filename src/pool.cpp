@@ -0,0 +1,161 @@
+/**
+ * @file pool.cpp
+ * @brief Implementation of \a ecv_pool.hpp
+ * @author lhm
+ */
+
+// Project's headers
+#include <ecv_pool.hpp>
+
+// Standard headers
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace ecv {
+
+using Clock = std::chrono::steady_clock;
+
+struct SolverPool::Impl
+{
+    struct Job
+    {
+        Task              _task;
+        Clock::time_point _submitted;
+    };
+
+    const size_t             _scratch;
+    std::deque<Job>          _jobs{};
+    std::vector<std::thread> _threads{};
+    mutable std::mutex       _mtx{};
+    std::condition_variable  _cv{};
+    bool                     _stop{ false };
+
+    // Metrics, updated under _mtx
+    size_t   _running{ 0 };
+    uint64_t _completed{ 0 }, _failed{ 0 };
+    double   _totalWait{ 0 }, _totalLatency{ 0 }, _maxLatency{ 0 };
+
+    explicit Impl(size_t scratch) noexcept
+      : _scratch{ scratch }
+    {}
+
+    void work(void) noexcept;
+};
+
+/*****************************************************************************/
+void
+SolverPool::Impl::work(void) noexcept
+{
+    std::vector<std::byte> buffer(_scratch); // Reused by every job of the worker
+
+    for (;;) {
+        Job               job{};
+        Clock::time_point start{};
+        {
+            std::unique_lock lock{ _mtx };
+            _cv.wait(lock, [this]() { return _stop || !std::empty(_jobs); });
+            if (std::empty(_jobs))
+                return; // Stopped, and nothing left to do
+
+            job = std::move(_jobs.front());
+            _jobs.pop_front();
+            start = Clock::now();
+            _totalWait += std::chrono::duration<double>(start - job._submitted).count();
+            ++_running;
+        }
+
+        bool failed{ false };
+        try {
+            std::pmr::monotonic_buffer_resource arena{ std::data(buffer), std::size(buffer) };
+            job._task(&arena);
+        } catch (...) {
+            failed = true; // The worker outlives the job
+        }
+
+        auto latency{ std::chrono::duration<double>(Clock::now() - job._submitted).count() };
+        std::lock_guard lock{ _mtx };
+        --_running;
+        ++_completed;
+        _failed += failed;
+        _totalLatency += latency;
+        _maxLatency = std::max(_maxLatency, latency);
+    }
+}
+
+/*****************************************************************************/
+SolverPool::SolverPool(size_t threads, size_t scratch) noexcept
+  : pimpl{ std::make_unique<Impl>(scratch) }
+{
+    if (0 == threads)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (size_t i{ 0 }; i < threads; ++i)
+        pimpl->_threads.emplace_back([this]() { pimpl->work(); });
+}
+
+/*****************************************************************************/
+SolverPool::~SolverPool() noexcept
+{
+    {
+        std::lock_guard lock{ pimpl->_mtx };
+        pimpl->_stop = true;
+    }
+    pimpl->_cv.notify_all();
+
+    for (auto& t : pimpl->_threads)
+        t.join();
+}
+
+/*****************************************************************************/
+void
+SolverPool::post(Task task) noexcept
+{
+    {
+        std::lock_guard lock{ pimpl->_mtx };
+        pimpl->_jobs.push_back({ std::move(task), Clock::now() });
+    }
+    pimpl->_cv.notify_one();
+}
+
+/*****************************************************************************/
+std::future<std::vector<std::vector<int>>>
+SolverPool::solve(const SparseMatrix& m, uint32_t max_solutions) noexcept
+{
+    return submit([m, max_solutions](std::pmr::memory_resource* scratch) {
+        std::vector<std::vector<int>> ret{};
+
+        auto problem{ GenericProblem::generate(m, scratch) };
+        if (nullptr != problem)
+            for (const auto& s : problem->solve(max_solutions))
+                ret.emplace_back(std::begin(s._d), std::end(s._d));
+
+        return ret;
+    });
+}
+
+/*****************************************************************************/
+SolverPool::Metrics
+SolverPool::metrics(void) const noexcept
+{
+    std::lock_guard lock{ pimpl->_mtx };
+
+    Metrics ret{};
+    ret._threads = std::size(pimpl->_threads);
+    ret._queued = std::size(pimpl->_jobs);
+    ret._running = pimpl->_running;
+    ret._completed = pimpl->_completed;
+    ret._failed = pimpl->_failed;
+    if (auto started{ ret._completed + ret._running }; 0 != started)
+        ret._meanWait = pimpl->_totalWait / started;
+    if (0 != ret._completed)
+        ret._meanLatency = pimpl->_totalLatency / ret._completed;
+    ret._maxLatency = pimpl->_maxLatency;
+    return ret;
+}
+
+} // namespace ecv
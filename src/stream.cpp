@@ -0,0 +1,357 @@
+/**
+ * @file stream.cpp
+ * @brief Implementation of \a ecv_stream.hpp
+ * @author lhm
+ */
+
+// Project's headers
+#include <ecv_stream.hpp>
+
+// Standard headers
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+namespace ecv {
+
+namespace {
+constexpr char     MAGIC[4]{ 'E', 'C', 'V', 'S' };
+constexpr uint32_t VERSION{ 1 };
+constexpr uint32_t SORTED{ 1 };                      // Header flag
+constexpr uint32_t MIN_BLOCK{ 64 };                  // Bounds of the block size
+constexpr uint32_t MAX_BLOCK{ uint32_t{ 1 } << 30 }; //
+constexpr size_t   MAX_VARINT{ 10 };                 // Bytes of a 64 bits varint
+
+// Largest difference between two ints, zigzag encoded
+constexpr uint64_t MAX_DELTA{ uint64_t{ 0xFFFFFFFF } << 1 };
+
+/*****************************************************************************/
+struct Header
+{
+    char     _magic[4];
+    uint32_t _version;
+    uint32_t _blockSize;
+    uint32_t _flags;
+};
+static_assert(16 == sizeof(Header), "Unexpected solution stream header size");
+
+/*****************************************************************************/
+struct BlockHeader
+{
+    uint32_t _count; // Solutions in the block
+    uint32_t _used;  // Bytes used by them
+};
+static_assert(8 == sizeof(BlockHeader), "Unexpected solution stream block header size");
+
+/*****************************************************************************/
+inline char*
+put(uint64_t v, char* p) noexcept
+{
+    for (; 0x80 <= v; v >>= 7)
+        *p++ = static_cast<char>(v | 0x80);
+    *p++ = static_cast<char>(v);
+    return p;
+}
+
+/*****************************************************************************/
+inline bool
+get(const char*& p, const char* end, uint64_t& v) noexcept
+{
+    v = 0;
+    for (unsigned shift{ 0 }; p < end && shift < 64; shift += 7) {
+        auto b{ static_cast<uint8_t>(*p++) };
+        v |= uint64_t{ b & 0x7Fu } << shift;
+        if (0 == (b & 0x80))
+            return true;
+    }
+    return false;
+}
+
+/*****************************************************************************/
+inline uint64_t
+zigzag(int64_t d) noexcept
+{
+    return (static_cast<uint64_t>(d) << 1) ^ static_cast<uint64_t>(d >> 63);
+}
+
+/*****************************************************************************/
+inline int64_t
+unzigzag(uint64_t v) noexcept
+{
+    return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+} // namespace
+
+struct SolutionWriter::Impl
+{
+    std::ostream&     _out;
+    DLX&              _problem;
+    const bool        _sorted;
+    const uint32_t    _blockSize;
+    std::vector<char> _block;                       // Current block, header included
+    size_t            _used{ sizeof(BlockHeader) }; // Bytes used in the current block
+    uint32_t          _size{ 0 };                   // Solutions in the current block
+    uint64_t          _count{ 0 };
+    std::vector<int>  _rows{};                      // Sorted rows of the current solution
+    std::vector<char> _sol{};                       // Current solution, encoded
+    bool              _failed{ false };             // A solution was lost
+
+    Impl(std::ostream& out, DLX& problem, bool sorted, uint32_t blockSize) noexcept
+      : _out{ out }
+      , _problem{ problem }
+      , _sorted{ sorted }
+      , _blockSize{ std::clamp(blockSize, MIN_BLOCK, MAX_BLOCK) }
+      , _block(_blockSize, 0)
+    {}
+
+    bool emit(void) noexcept;
+};
+
+/*****************************************************************************/
+bool
+SolutionWriter::Impl::emit(void) noexcept
+{
+    if (0 == _size)
+        return static_cast<bool>(_out);
+
+    BlockHeader h{ _size, static_cast<uint32_t>(_used - sizeof(BlockHeader)) };
+    std::memcpy(std::data(_block), &h, sizeof(BlockHeader));
+    std::fill(std::begin(_block) + _used, std::end(_block), 0);
+    _out.write(std::data(_block), _blockSize);
+
+    _used = sizeof(BlockHeader);
+    _size = 0;
+    return static_cast<bool>(_out);
+}
+
+/*****************************************************************************/
+SolutionWriter::SolutionWriter(std::ostream& out,
+                               DLX&          problem,
+                               bool          sorted,
+                               uint32_t      blockSize) noexcept
+  : pimpl{ std::make_unique<Impl>(out, problem, sorted, blockSize) }
+{
+    // The rows of a solution differ from the previous ones by twice the largest identifier at most
+    auto bounds{ problem.bounds() };
+    char buf[MAX_VARINT];
+    auto rowBytes{ put(zigzag(2 * static_cast<int64_t>(bounds._largest)), buf) - buf };
+    if (pimpl->_blockSize <
+        sizeof(BlockHeader) + (put(bounds._rows, buf) - buf) + bounds._rows * rowBytes) {
+        pimpl->_failed = true;
+        return;
+    }
+
+    Header h{};
+    std::memcpy(h._magic, MAGIC, sizeof(MAGIC));
+    h._version = VERSION;
+    h._blockSize = pimpl->_blockSize;
+    h._flags = sorted ? SORTED : 0;
+    out.write(reinterpret_cast<const char*>(&h), sizeof(Header));
+}
+
+/*****************************************************************************/
+SolutionWriter::~SolutionWriter() noexcept
+{
+    flush();
+}
+
+/*****************************************************************************/
+bool
+SolutionWriter::write(const std::pmr::vector<int>& rows) noexcept
+{
+    auto& impl{ *pimpl };
+    if (impl._failed)
+        return false;
+
+    auto first{ std::data(rows) };
+    auto last{ first + std::size(rows) };
+    if (impl._sorted) {
+        impl._rows.assign(first, last);
+        std::sort(std::begin(impl._rows), std::end(impl._rows));
+        first = std::data(impl._rows);
+        last = first + std::size(impl._rows);
+    }
+
+    // Encoded aside, as its size is only known afterwards
+    impl._sol.resize((std::size(rows) + 1) * MAX_VARINT);
+    auto end{ put(std::size(rows), std::data(impl._sol)) };
+    for (int64_t prev{ 0 }; first != last; prev = *first++)
+        end = put(zigzag(*first - prev), end);
+    auto size{ static_cast<size_t>(end - std::data(impl._sol)) };
+
+    if (impl._blockSize < impl._used + size && !impl.emit())
+        impl._failed = true;
+    else if (impl._blockSize < impl._used + size)
+        impl._failed = true; // Larger than a block
+    if (impl._failed)
+        return false;
+
+    std::memcpy(std::data(impl._block) + impl._used, std::data(impl._sol), size);
+    impl._used += size;
+    ++impl._size;
+    ++impl._count;
+    return true;
+}
+
+/*****************************************************************************/
+DLX::Visitor
+SolutionWriter::visitor(void) noexcept
+{
+    return [this](const std::pmr::vector<int>& rows) {
+        if (!write(rows))
+            pimpl->_problem.stop();
+    };
+}
+
+/*****************************************************************************/
+bool
+SolutionWriter::flush(void) noexcept
+{
+    return pimpl->emit() && pimpl->_out.flush() && !pimpl->_failed;
+}
+
+/*****************************************************************************/
+uint64_t
+SolutionWriter::count(void) const noexcept
+{
+    return pimpl->_count;
+}
+
+/*****************************************************************************/
+bool
+SolutionWriter::failed(void) const noexcept
+{
+    return pimpl->_failed;
+}
+
+struct SolutionReader::Impl
+{
+    std::istream&     _in;
+    bool              _valid{ false };
+    bool              _sorted{ false };
+    std::vector<char> _block{};
+    const char*       _p{ nullptr };   // Next solution in the current block
+    const char*       _end{ nullptr }; // End of the solutions of the current block
+    uint32_t          _left{ 0 };      // Solutions left in the current block
+    std::vector<int>  _rows{};         // Rows of the last solution, to rebuild its state
+
+    explicit Impl(std::istream& in) noexcept
+      : _in{ in }
+    {}
+
+    bool load(void) noexcept;
+};
+
+/*****************************************************************************/
+bool
+SolutionReader::Impl::load(void) noexcept
+{
+    _in.read(std::data(_block), std::size(_block));
+    if (0 == _in.gcount() && _in.eof())
+        return false; // End of the stream
+
+    BlockHeader h{};
+    std::memcpy(&h, std::data(_block), sizeof(BlockHeader));
+    if (static_cast<size_t>(_in.gcount()) != std::size(_block) || 0 == h._count ||
+        std::size(_block) - sizeof(BlockHeader) < h._used) {
+        _valid = false;
+        return false;
+    }
+
+    _p = std::data(_block) + sizeof(BlockHeader);
+    _end = _p + h._used;
+    _left = h._count;
+    return true;
+}
+
+/*****************************************************************************/
+SolutionReader::SolutionReader(std::istream& in) noexcept
+  : pimpl{ std::make_unique<Impl>(in) }
+{
+    Header h{};
+    if (!in.read(reinterpret_cast<char*>(&h), sizeof(Header)))
+        return;
+    if (0 != std::memcmp(h._magic, MAGIC, sizeof(MAGIC)) || VERSION != h._version ||
+        MIN_BLOCK > h._blockSize || MAX_BLOCK < h._blockSize)
+        return;
+
+    pimpl->_block.resize(h._blockSize);
+    pimpl->_sorted = (0 != (h._flags & SORTED));
+    pimpl->_valid = true;
+}
+
+/*****************************************************************************/
+SolutionReader::~SolutionReader() noexcept = default;
+
+/*****************************************************************************/
+bool
+SolutionReader::valid(void) const noexcept
+{
+    return pimpl->_valid;
+}
+
+/*****************************************************************************/
+bool
+SolutionReader::sorted(void) const noexcept
+{
+    return pimpl->_sorted;
+}
+
+/*****************************************************************************/
+bool
+SolutionReader::next(std::vector<int>& rows) noexcept
+{
+    auto& impl{ *pimpl };
+    if (!impl._valid)
+        return false;
+    if (0 == impl._left) {
+        // The solutions of a block must use all of its bytes
+        if (impl._p != impl._end) {
+            impl._valid = false;
+            return false;
+        }
+        if (!impl.load())
+            return false;
+    }
+
+    // Every row takes one byte at least
+    uint64_t n{ 0 };
+    if (!get(impl._p, impl._end, n) || static_cast<uint64_t>(impl._end - impl._p) < n) {
+        impl._valid = false;
+        return false;
+    }
+
+    rows.resize(n);
+    int64_t row{ 0 };
+    for (auto& r : rows) {
+        // Rows are ints : larger differences only come from malformed streams (and would overflow)
+        uint64_t v{ 0 };
+        if (!get(impl._p, impl._end, v) || MAX_DELTA < v) {
+            impl._valid = false;
+            return false;
+        }
+        row += unzigzag(v);
+        if (row < std::numeric_limits<int>::min() || std::numeric_limits<int>::max() < row) {
+            impl._valid = false;
+            return false;
+        }
+        r = static_cast<int>(row);
+    }
+
+    --impl._left;
+    return true;
+}
+
+/*****************************************************************************/
+bool
+SolutionReader::next(ConcreteProblem& problem, State& state) noexcept
+{
+    if (!next(pimpl->_rows))
+        return false;
+
+    state = problem.apply(pimpl->_rows);
+    return true;
+}
+
+} // namespace ecv
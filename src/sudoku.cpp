@@ -9,6 +9,10 @@
 
 namespace ecv {
 
+namespace {
+constexpr size_t N{ 9 };
+} // anonymous
+
 /*****************************************************************************/
 State
 Sudoku::make_empty_state() noexcept
@@ -19,16 +23,28 @@ Sudoku::make_empty_state() noexcept
 
 /*****************************************************************************/
 std::unique_ptr<Sudoku>
-Sudoku::generate(const State& state) noexcept
+Sudoku::generate(const State& state, std::pmr::memory_resource* resource) noexcept
 {
-    static constexpr size_t N{ 9 };
-
     if (N != std::size(state))
         return nullptr;
 
-    for (const auto& line : state)
+    std::pmr::string grid{ resource };
+    grid.reserve(N * N);
+    for (const auto& line : state) {
         if (N != std::size(line))
             return nullptr;
+        grid += line;
+    }
+
+    return parse(grid, resource);
+}
+
+/*****************************************************************************/
+std::unique_ptr<Sudoku>
+Sudoku::parse(std::string_view grid, std::pmr::memory_resource* resource) noexcept
+{
+    if (N * N != std::size(grid))
+        return nullptr;
 
     // Initial adjacency matrix dimensions ( without constraints )
     // - rows refer to the possible placements (placing a number in a cell : N * N * N)
@@ -39,19 +55,20 @@ Sudoku::generate(const State& state) noexcept
     //    - each number once per 3*3 area (N * N)
     auto rows{ N * N * N }, cols{ 4 * N * N };
 
-    for (const auto& line : state)
-        if (N != std::size(line))
-            return nullptr;
-
     // Constraints ( non-zero nodes on provided inputs )
-    auto authRows{ std::vector<int>(rows, 1) }, authCols{ std::vector<int>(cols, 1) };
+    std::pmr::vector<int> authRows(rows, 1, resource), authCols(cols, 1, resource);
+    std::pmr::string      initGrid(N * N, '0', resource);
 
     for (size_t i{ 0 }; i < N; ++i) {
         for (size_t j{ 0 }; j < N; ++j) {
-            auto val{ state[i][j] - '0' };
+            auto val{ ('.' == grid[i * N + j]) ? 0 : grid[i * N + j] - '0' };
+            if (0 > val || static_cast<int>(N) < val)
+                return nullptr;
             if (0 == val)
                 continue; // No constraint on the node
 
+            initGrid[i * N + j] = grid[i * N + j];
+
             for (size_t k{ 0 }; k < N; ++k) {
                 authRows[i * N * N + j * N + k] = 0;       // cannot put any val in the cell
                 authRows[i * N * N + k * N + val - 1] = 0; // cannot put val in the line
@@ -79,8 +96,12 @@ Sudoku::generate(const State& state) noexcept
     for (size_t i{ 0 }; i < cols; ++i)
         authCols[i] = authCols[i] ? C++ : -1;
 
-    auto             adj{ std::vector<bool>(R * C, false) };
-    std::vector<int> rowsList{};
+    // Every row has at most 4 non-zero entries, one per constraint type (in increasing order)
+    std::pmr::vector<uint64_t> offsets(1, 0, resource);
+    std::pmr::vector<uint32_t> indices{ resource };
+    std::pmr::vector<int>      rowsList{ resource };
+    offsets.reserve(R + 1);
+    indices.reserve(4 * R);
     rowsList.reserve(R);
 
     for (size_t i{ 0 }; i < N; ++i) {
@@ -92,63 +113,63 @@ Sudoku::generate(const State& state) noexcept
                 rowsList.push_back(r);
                 size_t c1{ i * N + j }, c2{ N * N + i * N + k }, c3{ 2 * N * N + j * N + k },
                   c4{ 3 * N * N + (3 * (i / 3) + (j / 3)) * N + k };
-                if (authCols[c1] != -1)
-                    adj[authRows[r] * C + authCols[c1]] = true;
-                if (authCols[c2] != -1)
-                    adj[authRows[r] * C + authCols[c2]] = true;
-                if (authCols[c3] != -1)
-                    adj[authRows[r] * C + authCols[c3]] = true;
-                if (authCols[c4] != -1)
-                    adj[authRows[r] * C + authCols[c4]] = true;
+                for (auto c : { c1, c2, c3, c4 })
+                    if (authCols[c] != -1)
+                        indices.push_back(authCols[c]);
+                offsets.push_back(std::size(indices));
             }
         }
     }
 
     struct shared_enabler : public Sudoku
     {
-        shared_enabler(const std::vector<bool>& data,
-                       size_t                   rows,
-                       size_t                   cols,
-                       const std::vector<int>&  rowsList,
-                       const State&             state)
-          : Sudoku(data, rows, cols, rowsList, state)
+        shared_enabler(const SparseMatrix&          m,
+                       const std::pmr::vector<int>& rowsList,
+                       std::string_view             initGrid,
+                       std::pmr::memory_resource*   resource)
+          : Sudoku(m, rowsList, initGrid, resource)
         {}
     };
 
-    return std::make_unique<shared_enabler>(adj, R, C, rowsList, state);
+    return std::make_unique<shared_enabler>(
+      SparseMatrix{ R, C, -1, offsets.data(), indices.data() }, rowsList, initGrid, resource);
 }
 
 /*****************************************************************************/
-Sudoku::Sudoku(const std::vector<bool>& data,
-               size_t                   rows,
-               size_t                   cols,
-               const std::vector<int>&  rowsList,
-               const State&             initStata) noexcept
-  : ConcreteProblem(data, rows, cols, rowsList)
-  , _initState{ initStata }
+Sudoku::Sudoku(const SparseMatrix&          m,
+               const std::pmr::vector<int>& rowsList,
+               std::string_view             initGrid,
+               std::pmr::memory_resource*   resource) noexcept
+  : ConcreteProblem(m, rowsList, resource)
+  , _initGrid{ initGrid, resource }
 {}
 
 /*****************************************************************************/
 State
 Sudoku::apply(const Solution& s) noexcept
 {
-    auto ret{ _initState };
+    std::string grid{};
+    apply(s, grid);
 
-    if (std::empty(ret))
-        return ret;
+    State ret{};
+    ret.reserve(N);
+    for (size_t i{ 0 }; i < N; ++i)
+        ret.emplace_back(grid, i * N, N);
 
-    auto R{ std::size(_initState) }, C{ std::size(_initState[0]) };
+    return ret;
+}
 
-    for (const auto& line : s._d) {
-        if (static_cast<size_t>(line) > R * R * C)
-            return ret;
-        auto pos{ line / R };
-        auto val{ (line % R) + 1 };
+/*****************************************************************************/
+void
+Sudoku::apply(const Solution& s, std::string& grid) const noexcept
+{
+    grid.assign(_initGrid);
 
-        ret[pos / C][pos % C] = (0 == val) ? R + '0' : val + '0';
+    for (const auto& line : s._d) {
+        if (static_cast<size_t>(line) >= N * N * N)
+            return;
+        grid[line / N] = (line % N) + '1';
     }
-
-    return ret;
 }
 
 } // namespace ecv
@@ -0,0 +1,222 @@
+/**
+ * @file ecv-bench.cpp
+ * @brief Benchmark comparing the engines of the ecv library
+ * @author lhm
+ */
+
+// Project's headers
+#include <ecv.hpp>
+#include <ecv_fixed.hpp>
+
+// Standard headers
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+using namespace ecv;
+
+// The compile-time problems are header-only : instantiated whole, so that the build checks them
+template class ecv::fixed::Sudoku<3>;
+template class ecv::fixed::LatinSquares<5>;
+template class ecv::fixed::NQueens<8>;
+
+namespace {
+// Hard sudokus (for DLX) from the usual benchmark lists
+constexpr const char* SUDOKUS[]{
+    "4.....8.5.3..........7......2.....6.....8.4......1.......6.3.7.5..2.....1.4......",
+    "52...6.........7.13...........4..8..6......5...........418.........3..2...87.....",
+    "6.....8.3.4.7.................5.4.7.3..2.....1.6.......2.....5.....8.6......1....",
+    "48.3............71.2.......7.5....6....2..8.............1.76...3.....4......5....",
+    "....14....3....2...7..........9...3.6.1.............8.2.....1.4....5.6.....7.8...",
+    "......52..8.4......3...9...5.1...6..2..7........3.....6...1..........7.4.......3.",
+    "6.2.5.........3.4..........43...8....1....2........7..5..27...........81...6.....",
+    ".524.........7.1..............8.2...3.....6...9.5.....1.6.3...........897........",
+    "6.2.5.........4.3..........43...8....1....2........7..5..27...........81...6.....",
+    ".923.........8.1...........1.7.4...........658.........6.5.2...4.....7.....9....."
+};
+
+struct Engines
+{
+    const char* _name;
+    Engine      _engine;
+};
+
+constexpr Engines ENGINES[]{ { "links", Engine::Links },
+                             { "cells", Engine::Cells },
+                             { "bitboard", Engine::Bitboard },
+                             { "learning", Engine::Learning } };
+
+/*****************************************************************************/
+void
+run(const char* bench, const std::function<uint64_t(Engine)>& f, Engine engine, const char* name)
+{
+    auto start{ std::chrono::steady_clock::now() };
+    auto result{ f(engine) };
+    auto elapsed{ std::chrono::duration<double>(std::chrono::steady_clock::now() - start) };
+
+    if (std::numeric_limits<uint64_t>::max() == result)
+        return; // Engine not supported
+    std::printf("%-28s %-9s %10.3f s %14llu\n",
+                bench,
+                name,
+                elapsed.count(),
+                static_cast<unsigned long long>(result));
+}
+
+/*****************************************************************************/
+uint64_t
+select(DLX& problem, Engine engine, uint64_t max_solutions)
+{
+    if (!problem.set_engine(engine))
+        return std::numeric_limits<uint64_t>::max();
+    return problem.count(max_solutions);
+}
+
+/*****************************************************************************/
+template<size_t N>
+uint64_t
+fixedQueens(void)
+{
+    return fixed::NQueens<N>::parse(std::string(N * N, '0'))->count();
+}
+
+/*****************************************************************************/
+uint64_t
+mutilated(Engine engine, int n)
+{
+    // Dominoes tiling of a n * n chessboard missing two opposite corners : there is none
+    std::vector<uint64_t> offsets{ 0 };
+    std::vector<uint32_t> indices{};
+    auto cell{ [n](int r, int c) { return static_cast<uint32_t>(r * n + c - 1); } };
+    auto removed{ [n](int r, int c) { return (0 == r && 0 == c) || (n - 1 == r && n - 1 == c); } };
+    for (int r{ 0 }; r < n; ++r) {
+        for (int c{ 0 }; c < n; ++c) {
+            if (removed(r, c))
+                continue;
+            if (c + 1 < n && !removed(r, c + 1)) {
+                indices.insert(std::end(indices), { cell(r, c), cell(r, c + 1) });
+                offsets.push_back(std::size(indices));
+            }
+            if (r + 1 < n && !removed(r + 1, c)) {
+                indices.insert(std::end(indices), { cell(r, c), cell(r + 1, c) });
+                offsets.push_back(std::size(indices));
+            }
+        }
+    }
+
+    auto problem{ GenericProblem::generate(SparseMatrix{ std::size(offsets) - 1,
+                                                         static_cast<size_t>(n * n - 2),
+                                                         -1,
+                                                         std::data(offsets),
+                                                         std::data(indices) }) };
+    return select(*problem, engine, std::numeric_limits<uint64_t>::max());
+}
+
+} // anonymous
+
+/*****************************************************************************/
+int
+main(int argc, char** argv)
+{
+    int queens{ (1 < argc) ? std::atoi(argv[1]) : 12 };
+
+    std::setvbuf(stdout, nullptr, _IOLBF, 0);
+    std::printf("%-28s %-9s %12s %14s\n", "benchmark", "engine", "time", "solutions");
+
+    for (const auto& e : ENGINES) {
+        run(
+          "sudoku (10 hard, unicity)",
+          [](Engine engine) {
+              uint64_t ret{ 0 };
+              for (const auto* grid : SUDOKUS) {
+                  auto problem{ Sudoku::parse(grid) };
+                  auto count{ select(*problem, engine, 2) };
+                  if (std::numeric_limits<uint64_t>::max() == count)
+                      return count;
+                  ret += count;
+              }
+              return ret;
+          },
+          e._engine,
+          e._name);
+    }
+    run(
+      "sudoku (10 hard, unicity)",
+      [](Engine) {
+          uint64_t ret{ 0 };
+          for (const auto* grid : SUDOKUS)
+              ret += fixed::Sudoku<3>::parse(grid)->count(2);
+          return ret;
+      },
+      Engine::Links,
+      "fixed");
+
+    auto queensName{ std::to_string(queens) + "-queens (count)" };
+    for (const auto& e : ENGINES) {
+        run(
+          queensName.c_str(),
+          [queens](Engine engine) {
+              auto problem{ NQueens::generate(NQueens::make_empty_state(queens)) };
+              return select(*problem, engine, std::numeric_limits<uint64_t>::max());
+          },
+          e._engine,
+          e._name);
+    }
+    run(
+      queensName.c_str(),
+      [queens](Engine) {
+          switch (queens) {
+              case 8:
+                  return fixedQueens<8>();
+              case 10:
+                  return fixedQueens<10>();
+              case 12:
+                  return fixedQueens<12>();
+              default:
+                  return std::numeric_limits<uint64_t>::max(); // Size not compiled in
+          }
+      },
+      Engine::Links,
+      "fixed");
+
+    for (const auto& e : ENGINES) {
+        run(
+          "latin squares 5x5 (count)",
+          [](Engine engine) {
+              auto problem{ LatinSquares::generate(LatinSquares::make_empty_state(5, 5)) };
+              return select(*problem, engine, std::numeric_limits<uint64_t>::max());
+          },
+          e._engine,
+          e._name);
+    }
+    run(
+      "latin squares 5x5 (count)",
+      [](Engine) { return fixed::LatinSquares<5>::parse(std::string(5 * 5, '0'))->count(); },
+      Engine::Links,
+      "fixed");
+
+    // Unsatisfiable : a search not learning from its failures meets the same ones again and again
+    for (const auto& e : ENGINES) {
+        run(
+          "mutilated chessboard 8x8",
+          [](Engine engine) { return mutilated(engine, 8); },
+          e._engine,
+          e._name);
+    }
+
+    // Large instance (64000 rows, 4800 columns) : memory access patterns matter
+    for (const auto& e : ENGINES) {
+        run(
+          "latin squares 40x40 (100000)",
+          [](Engine engine) {
+              auto problem{ LatinSquares::parse(std::string(40 * 40, '0')) };
+              return select(*problem, engine, 100000);
+          },
+          e._engine,
+          e._name);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,478 @@
+/**
+ * @file ecv-solve.cpp
+ * @brief Command-line solver processing puzzle dumps with a parallel I/O pipeline
+ * @author lhm
+ *
+ * One puzzle per input line :
+ *  - sudoku : the 81 cells of the grid ('0' or '.' for empty cells)
+ *  - latin  : the N * N cells of the grid ('0' or '.' for empty cells)
+ *  - cover  : the path of a binary cover file (\see GenericProblem::load)
+ *
+ * The reader hands batches of lines to a pool of solver threads through a bounded queue,
+ * and the results are written in input order, one line per puzzle.
+ */
+
+// Project's headers
+#include <ecv.hpp>
+
+// Standard headers
+#include <algorithm>
+#include <condition_variable>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+// System headers
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace ecv;
+
+namespace {
+constexpr size_t CHUNK_SIZE{ 4 << 20 }; // Size of the blocks read from non-mappable inputs
+constexpr size_t BATCH_SIZE{ 1024 };    // Number of puzzles per batch
+constexpr size_t ARENA_SIZE{ 1 << 20 }; // Per-thread memory every puzzle is solved from
+constexpr size_t MAX_THREADS{ 1024 };   // Solver threads, at most
+
+enum class Kind
+{
+    Sudoku,
+    Latin,
+    Cover
+};
+
+struct Options
+{
+    Kind        _kind{ Kind::Sudoku };
+    size_t      _threads{ std::max(1u, std::thread::hardware_concurrency()) };
+    uint64_t    _max{ std::numeric_limits<uint64_t>::max() }; // Solutions counted
+    bool        _count{ false };
+    const char* _input{ nullptr };
+};
+
+/*****************************************************************************/
+struct Batch
+{ ///< A bunch of consecutive input lines, and the matching output
+    size_t                             _seq{ 0 };
+    std::shared_ptr<const std::string> _storage{}; // Owns the lines when the input is not mapped
+    std::vector<std::string_view>      _lines{};
+    std::string                        _out{};
+};
+
+/*****************************************************************************/
+template<typename T>
+class BoundedQueue
+{
+public:
+    explicit BoundedQueue(size_t capacity) noexcept
+      : _capacity{ capacity }
+    {}
+
+    void push(T&& item)
+    {
+        std::unique_lock<std::mutex> lock{ _mtx };
+        _notFull.wait(lock, [this] { return std::size(_items) < _capacity; });
+        _items.push_back(std::move(item));
+        _notEmpty.notify_one();
+    }
+
+    std::optional<T> pop()
+    {
+        std::unique_lock<std::mutex> lock{ _mtx };
+        _notEmpty.wait(lock, [this] { return _closed || !std::empty(_items); });
+        if (std::empty(_items))
+            return std::nullopt;
+
+        auto ret{ std::move(_items.front()) };
+        _items.pop_front();
+        _notFull.notify_one();
+        return ret;
+    }
+
+    void close()
+    {
+        std::lock_guard<std::mutex> lock{ _mtx };
+        _closed = true;
+        _notEmpty.notify_all();
+    }
+
+private:
+    const size_t            _capacity;
+    std::deque<T>           _items{};
+    bool                    _closed{ false };
+    std::mutex              _mtx{};
+    std::condition_variable _notFull{}, _notEmpty{};
+};
+
+/*****************************************************************************/
+class Reorderer
+{ ///< Gives the solved batches back in input order, and bounds the number of batches in flight
+public:
+    explicit Reorderer(size_t inFlight) noexcept
+      : _inFlight{ inFlight }
+    {}
+
+    void acquire(size_t seq)
+    {
+        std::unique_lock<std::mutex> lock{ _mtx };
+        _cv.wait(lock, [this, seq] { return seq < _next + _inFlight; });
+    }
+
+    void done(Batch&& batch)
+    {
+        std::lock_guard<std::mutex> lock{ _mtx };
+        auto                        seq{ batch._seq };
+        _ready.emplace(seq, std::move(batch));
+        _cv.notify_all();
+    }
+
+    void finish(size_t total)
+    {
+        std::lock_guard<std::mutex> lock{ _mtx };
+        _total = total;
+        _cv.notify_all();
+    }
+
+    std::optional<Batch> next()
+    {
+        std::unique_lock<std::mutex> lock{ _mtx };
+        _cv.wait(lock,
+                 [this] { return _next == _total || std::end(_ready) != _ready.find(_next); });
+        if (_next == _total)
+            return std::nullopt;
+
+        auto it{ _ready.find(_next) };
+        auto ret{ std::move(it->second) };
+        _ready.erase(it);
+        ++_next;
+        _cv.notify_all();
+        return ret;
+    }
+
+private:
+    const size_t            _inFlight;
+    size_t                  _next{ 0 };
+    size_t                  _total{ std::numeric_limits<size_t>::max() };
+    std::map<size_t, Batch> _ready{};
+    std::mutex              _mtx{};
+    std::condition_variable _cv{};
+};
+
+/*****************************************************************************/
+template<typename Problem>
+void
+solveGrid(const Options&             opts,
+          std::string_view           line,
+          std::pmr::memory_resource* arena,
+          std::string&               grid,
+          std::string&               out)
+{
+    auto problem{ Problem::parse(line, arena) };
+    if (nullptr == problem) {
+        out += "invalid";
+        return;
+    }
+
+    if (opts._count) {
+        out += std::to_string(problem->count(opts._max));
+        return;
+    }
+
+    auto solutions{ problem->solve(1) };
+    if (std::empty(solutions))
+        out += "unsolvable";
+    else {
+        problem->apply(solutions[0], grid);
+        out += grid;
+    }
+}
+
+/*****************************************************************************/
+void
+solveCover(const Options&             opts,
+           std::string_view           line,
+           std::pmr::memory_resource* arena,
+           std::string&               out)
+{
+    auto problem{ GenericProblem::load(std::string{ line }, arena) };
+    if (nullptr == problem) {
+        out += "invalid";
+        return;
+    }
+
+    if (opts._count) {
+        out += std::to_string(problem->count(opts._max));
+        return;
+    }
+
+    auto solutions{ problem->solve(1) };
+    if (std::empty(solutions))
+        out += "unsolvable";
+    else {
+        auto rows{ solutions[0]._d };
+        std::sort(std::begin(rows), std::end(rows));
+        for (size_t i{ 0 }; i < std::size(rows); ++i)
+            (out += (0 == i) ? "" : " ") += std::to_string(rows[i]);
+    }
+}
+
+/*****************************************************************************/
+void
+worker(const Options& opts, BoundedQueue<Batch>& queue, Reorderer& reorderer)
+{
+    std::string            grid{}; // Reused for every puzzle of the thread
+    std::vector<std::byte> buffer(ARENA_SIZE);
+    while (auto batch{ queue.pop() }) {
+        batch->_out.reserve(std::size(batch->_lines) * 82);
+        for (const auto& line : batch->_lines) {
+            // Everything allocated for the puzzle is released at once (larger ones spill over
+            // to the heap)
+            std::pmr::monotonic_buffer_resource arena{ std::data(buffer), std::size(buffer) };
+            switch (opts._kind) {
+                case Kind::Sudoku:
+                    solveGrid<Sudoku>(opts, line, &arena, grid, batch->_out);
+                    break;
+                case Kind::Latin:
+                    solveGrid<LatinSquares>(opts, line, &arena, grid, batch->_out);
+                    break;
+                case Kind::Cover:
+                    solveCover(opts, line, &arena, batch->_out);
+                    break;
+            }
+            batch->_out += '\n';
+        }
+        reorderer.done(std::move(*batch));
+    }
+}
+
+/*****************************************************************************/
+class Reader
+{ ///< Splits the input into batches of lines, memory-mapping it whenever possible
+public:
+    Reader(const Options& opts, BoundedQueue<Batch>& queue, Reorderer& reorderer) noexcept
+      : _batchSize{ (Kind::Cover == opts._kind) ? 1 : BATCH_SIZE }
+      , _queue{ queue }
+      , _reorderer{ reorderer }
+    {}
+
+    bool run(const char* path)
+    {
+        auto fd{ (nullptr == path) ? STDIN_FILENO : ::open(path, O_RDONLY) };
+        if (-1 == fd)
+            return false;
+
+        struct stat st;
+        if (0 == ::fstat(fd, &st) && S_ISREG(st.st_mode) && 0 < st.st_size) {
+            auto addr{ ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0) };
+            if (MAP_FAILED != addr) {
+                ::madvise(addr, st.st_size, MADV_SEQUENTIAL);
+                split(std::string_view{ static_cast<const char*>(addr),
+                                        static_cast<size_t>(st.st_size) },
+                      nullptr);
+                _reorderer.finish(_seq);
+                _queue.close();
+                // Every batch has to be written before the lines can be unmapped
+                _mapping = { addr, st.st_size };
+                if (STDIN_FILENO != fd)
+                    ::close(fd);
+                return true;
+            }
+        }
+
+        // Large buffered reads otherwise, the batches sharing the chunk of complete lines they
+        // refer to
+        std::string pending{};
+        for (bool eof{ false }; !eof;) {
+            auto chunk{ std::make_shared<std::string>() };
+            chunk->swap(pending);
+            auto size{ std::size(*chunk) };
+            chunk->resize(size + CHUNK_SIZE);
+
+            auto n{ ::read(fd, chunk->data() + size, CHUNK_SIZE) };
+            eof = (0 >= n);
+            chunk->resize(size + std::max<ssize_t>(n, 0));
+
+            auto last{ eof ? std::size(*chunk) : chunk->rfind('\n') + 1 };
+            if (!eof && 0 == last) {
+                pending.swap(*chunk); // No complete line yet
+                continue;
+            }
+            pending.assign(*chunk, last);
+            chunk->resize(last);
+
+            split(*chunk, chunk);
+        }
+
+        _reorderer.finish(_seq);
+        _queue.close();
+        if (STDIN_FILENO != fd)
+            ::close(fd);
+        return true;
+    }
+
+    ~Reader() noexcept
+    {
+        if (nullptr != _mapping.first)
+            ::munmap(_mapping.first, _mapping.second);
+    }
+
+private:
+    void split(std::string_view data, const std::shared_ptr<const std::string>& storage)
+    {
+        Batch batch{};
+        batch._storage = storage;
+        for (size_t pos{ 0 }; pos < std::size(data);) {
+            auto end{ data.find('\n', pos) };
+            if (std::string_view::npos == end)
+                end = std::size(data);
+
+            auto line{ data.substr(pos, end - pos) };
+            if (!std::empty(line) && '\r' == line.back())
+                line.remove_suffix(1);
+            if (!std::empty(line))
+                batch._lines.push_back(line);
+            pos = end + 1;
+
+            if (_batchSize == std::size(batch._lines))
+                flush(batch);
+        }
+        flush(batch);
+    }
+
+    void flush(Batch& batch)
+    {
+        if (std::empty(batch._lines))
+            return;
+
+        auto storage{ batch._storage };
+        batch._seq = _seq++;
+        _reorderer.acquire(batch._seq);
+        _queue.push(std::move(batch));
+        batch = Batch{};
+        batch._storage = storage;
+    }
+
+    const size_t                  _batchSize;
+    BoundedQueue<Batch>&          _queue;
+    Reorderer&                    _reorderer;
+    size_t                        _seq{ 0 };
+    std::pair<void*, std::size_t> _mapping{ nullptr, 0 };
+};
+
+/*****************************************************************************/
+void
+usage(const char* name)
+{
+    std::fprintf(stderr,
+                 "Usage: %s [-t sudoku|latin|cover] [-j threads] [-n max_solutions] [-c] [file]\n"
+                 "  -t  kind of puzzles, one per line (default: sudoku)\n"
+                 "  -j  number of solver threads (default: number of cores)\n"
+                 "  -n  maximum number of solutions to count (default: all)\n"
+                 "  -c  print the number of solutions instead of the first one\n"
+                 "Reads the standard input when no file is given.\n",
+                 name);
+}
+
+/*****************************************************************************/
+std::optional<uint64_t>
+parsePositive(const char* arg) noexcept
+{
+    char* end{ nullptr };
+    errno = 0;
+    auto ret{ std::strtoull(arg, &end, 10) };
+    if ('\0' != *end || arg == end || '-' == *arg || ERANGE == errno || 0 == ret)
+        return std::nullopt;
+    return ret;
+}
+
+/*****************************************************************************/
+std::optional<Options>
+parseArgs(int argc, char** argv)
+{
+    Options opts{};
+    for (int i{ 1 }; i < argc; ++i) {
+        std::string_view arg{ argv[i] };
+        if ("-c" == arg)
+            opts._count = true;
+        else if ("-t" == arg && i + 1 < argc) {
+            std::string_view kind{ argv[++i] };
+            if ("sudoku" == kind)
+                opts._kind = Kind::Sudoku;
+            else if ("latin" == kind)
+                opts._kind = Kind::Latin;
+            else if ("cover" == kind)
+                opts._kind = Kind::Cover;
+            else
+                return std::nullopt;
+        } else if ("-j" == arg && i + 1 < argc) {
+            auto threads{ parsePositive(argv[++i]) };
+            if (!threads || MAX_THREADS < *threads)
+                return std::nullopt;
+            opts._threads = *threads;
+        } else if ("-n" == arg && i + 1 < argc) {
+            auto max{ parsePositive(argv[++i]) };
+            if (!max)
+                return std::nullopt;
+            opts._max = *max;
+        } else if ('-' != arg[0] && nullptr == opts._input)
+            opts._input = argv[i];
+        else
+            return std::nullopt;
+    }
+    return opts;
+}
+
+} // anonymous
+
+/*****************************************************************************/
+int
+main(int argc, char** argv)
+{
+    auto opts{ parseArgs(argc, argv) };
+    if (!opts) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    static char outBuffer[1 << 20];
+    std::setvbuf(stdout, outBuffer, _IOFBF, sizeof(outBuffer));
+
+    BoundedQueue<Batch>      queue{ 2 * opts->_threads };
+    Reorderer                reorderer{ 4 * opts->_threads };
+    std::vector<std::thread> workers{};
+    for (size_t i{ 0 }; i < opts->_threads; ++i)
+        workers.emplace_back(worker, std::cref(*opts), std::ref(queue), std::ref(reorderer));
+
+    Reader reader{ *opts, queue, reorderer };
+    bool   ok{ true };
+    auto   feeder{ std::thread{ [&] {
+        if (!(ok = reader.run(opts->_input))) {
+            reorderer.finish(0);
+            queue.close();
+        }
+    } } };
+
+    while (auto batch{ reorderer.next() })
+        std::fwrite(batch->_out.data(), 1, std::size(batch->_out), stdout);
+    std::fflush(stdout);
+
+    feeder.join();
+    for (auto& w : workers)
+        w.join();
+
+    if (!ok) {
+        std::fprintf(stderr, "%s: cannot read %s\n", argv[0], opts->_input);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}